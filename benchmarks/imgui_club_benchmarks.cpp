@@ -0,0 +1,282 @@
+// Headless benchmarks for imgui_club extensions
+// (memory editor configurations, multi-context compositor with many contexts)
+//
+// No backend or GPU is needed: contexts are created with a built font atlas and a display size, then NewFrame()/Render() are called in a loop.
+// For each configuration, prints average frame time, vertices and number of allocations per frame.
+//
+// Build (pass the path to your Dear ImGui checkout as an include path):
+//   c++ -O2 -std=c++11 -I<imgui_dir> -I../imgui_memory_editor -I../imgui_multicontext_compositor imgui_club_benchmarks.cpp
+//       ../imgui_multicontext_compositor/imgui_multicontext_compositor.cpp
+//       <imgui_dir>/imgui.cpp <imgui_dir>/imgui_draw.cpp <imgui_dir>/imgui_tables.cpp <imgui_dir>/imgui_widgets.cpp -o imgui_club_benchmarks
+// Usage:
+//   imgui_club_benchmarks [frames_count] [memory_editor|compositor]
+
+#include "imgui.h"
+#include "imgui_memory_editor.h"
+#include "imgui_multicontext_compositor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static int g_allocs_count = 0;
+static void* CountingAlloc(size_t size, void*)  { g_allocs_count++; return malloc(size); }
+static void  CountingFree(void* ptr, void*)     { free(ptr); }
+
+static double GetTimeSeconds(void* = NULL)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct FrameResults
+{
+    double  FrameMs = 0.0;
+    double  VtxCount = 0.0;
+    double  AllocsCount = 0.0;
+};
+
+static ImGuiContext* CreateBenchmarkContext(ImFontAtlas* shared_atlas)
+{
+    ImGuiContext* ctx = ImGui::CreateContext(shared_atlas);
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    return ctx;
+}
+
+//-----------------------------------------------------------------------------
+// Memory editor
+// - Cols 8..64, HexII, Ascii, handlers (none, ReadFn, ReadRangeFn, ReadRangeFn + BgColorFn + HighlightFn), sizes from 64 KB to 1 TB (handlers only above 16 MB).
+//-----------------------------------------------------------------------------
+
+enum HandlersMode { Handlers_None, Handlers_ReadFn, Handlers_ReadRangeFn, Handlers_ReadRangeFnBgColorFn, Handlers_COUNT };
+static const char* HandlersModeNames[Handlers_COUNT] = { "none", "ReadFn", "ReadRangeFn", "ReadRange+BgColor+Highlight" };
+
+// Synthetic contents, so multi-GB/TB address spaces don't need memory
+static ImU8 SyntheticByte(size_t off)                                               { ImU32 h = (ImU32)(off * 2654435761u) ^ (ImU32)(off >> 32); return (off % 64 < 16) ? 0 : (ImU8)(h >> 24); }
+static ImU8 BenchReadFn(const ImU8*, size_t off, void*)                             { return SyntheticByte(off); }
+static void BenchReadRangeFn(const ImU8*, size_t off, ImU8* out, size_t size, void*) { for (size_t n = 0; n < size; n++) out[n] = SyntheticByte(off + n); }
+static ImU32 BenchBgColorFn(const ImU8*, size_t off, void*)                         { return ((off / 256) & 1) ? IM_COL32(0, 80, 160, 60) : 0; }
+static bool BenchHighlightFn(const ImU8*, size_t off, void*)                        { return (off % 1024) < 8; }
+
+static FrameResults RunMemoryEditor(ImGuiContext* ctx, ImU8* data, size_t data_size, size_t mem_size, int cols, bool hexii, bool ascii, int handlers, int frames_count)
+{
+    ImGui::SetCurrentContext(ctx);
+    MemoryEditor mem_edit;
+    mem_edit.Cols = cols;
+    mem_edit.OptShowHexII = hexii;
+    mem_edit.OptShowAscii = ascii;
+    if (handlers == Handlers_ReadFn)
+        mem_edit.ReadFn = BenchReadFn;
+    if (handlers >= Handlers_ReadRangeFn)
+        mem_edit.ReadRangeFn = BenchReadRangeFn;
+    if (handlers == Handlers_ReadRangeFnBgColorFn)
+    {
+        mem_edit.BgColorFn = BenchBgColorFn;
+        mem_edit.HighlightFn = BenchHighlightFn;
+    }
+    IM_ASSERT(handlers != Handlers_None || mem_size <= data_size);
+
+    FrameResults results;
+    const int warmup_frames_count = 5;
+    for (int frame = 0; frame < warmup_frames_count + frames_count; frame++)
+    {
+        const int allocs_before = g_allocs_count;
+        const double time_start = GetTimeSeconds();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Memory Editor", NULL, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings);
+        mem_edit.DrawContents(data, mem_size);
+        ImGui::End();
+        ImGui::Render();
+        if (frame < warmup_frames_count)
+            continue;
+        results.FrameMs += (GetTimeSeconds() - time_start) * 1000.0;
+        results.VtxCount += ImGui::GetDrawData()->TotalVtxCount;
+        results.AllocsCount += g_allocs_count - allocs_before;
+    }
+    results.FrameMs /= frames_count;
+    results.VtxCount /= frames_count;
+    results.AllocsCount /= frames_count;
+    return results;
+}
+
+static void BenchmarkMemoryEditor(ImFontAtlas* atlas, int frames_count)
+{
+    const size_t data_size = 16 * 1024 * 1024;
+    ImU8* data = (ImU8*)malloc(data_size);
+    for (size_t n = 0; n < data_size; n++)
+        data[n] = SyntheticByte(n);
+
+    size_t mem_sizes[4] = { 64 * 1024, data_size, 0, 0 };
+    int mem_sizes_count = 2;
+    mem_sizes[mem_sizes_count++] = (size_t)1 << 30;             // 1 GB
+    if (sizeof(size_t) >= 8)
+        mem_sizes[mem_sizes_count++] = (size_t)((ImU64)1 << 40); // 1 TB, 64-bit builds only
+    const int cols_values[] = { 8, 16, 32, 64 };
+
+    ImGuiContext* ctx = CreateBenchmarkContext(atlas);
+    printf("# Memory editor (%d frames per configuration)\n", frames_count);
+    printf("%-10s %4s %5s %5s %-28s %10s %10s %10s\n", "mem_size", "cols", "hexii", "ascii", "handlers", "frame_ms", "vtx", "allocs");
+    for (int size_n = 0; size_n < mem_sizes_count; size_n++)
+        for (int handlers = 0; handlers < Handlers_COUNT; handlers++)
+        {
+            if (handlers == Handlers_None && mem_sizes[size_n] > data_size)
+                continue;
+            for (int cols_n = 0; cols_n < IM_ARRAYSIZE(cols_values); cols_n++)
+                for (int hexii = 0; hexii < 2; hexii++)
+                    for (int ascii = 0; ascii < 2; ascii++)
+                    {
+                        FrameResults r = RunMemoryEditor(ctx, data, data_size, mem_sizes[size_n], cols_values[cols_n], hexii != 0, ascii != 0, handlers, frames_count);
+                        char size_buf[32];
+                        const size_t mem_size = mem_sizes[size_n];
+                        if ((ImU64)mem_size >= ((ImU64)1 << 40))   snprintf(size_buf, sizeof(size_buf), "%d TB", (int)((ImU64)mem_size >> 40));
+                        else if (mem_size >= ((size_t)1 << 30))    snprintf(size_buf, sizeof(size_buf), "%d GB", (int)(mem_size >> 30));
+                        else if (mem_size >= ((size_t)1 << 20))    snprintf(size_buf, sizeof(size_buf), "%d MB", (int)(mem_size >> 20));
+                        else                                        snprintf(size_buf, sizeof(size_buf), "%d KB", (int)(mem_size >> 10));
+                        printf("%-10s %4d %5d %5d %-28s %10.3f %10.0f %10.1f\n", size_buf, cols_values[cols_n], hexii, ascii, HandlersModeNames[handlers], r.FrameMs, r.VtxCount, r.AllocsCount);
+                    }
+        }
+    ImGui::DestroyContext(ctx);
+    free(data);
+}
+
+//-----------------------------------------------------------------------------
+// Multi-context compositor
+// - 2..64 contexts, each with its own overlapping window. Mouse moves over them so input routing changes every few frames.
+//-----------------------------------------------------------------------------
+
+static FrameResults RunCompositor(ImFontAtlas* atlas, int contexts_count, bool merged_draw_data, int frames_count, double* out_compositor_ms)
+{
+    ImGuiMultiContextCompositor mcc;
+    ImVector<ImGuiContext*> contexts;
+    for (int n = 0; n < contexts_count; n++)
+    {
+        contexts.push_back(CreateBenchmarkContext(atlas));
+        ImGuiMultiContextCompositor_AddContext(&mcc, contexts.back());
+    }
+
+    FrameResults results;
+    double compositor_ms = 0.0;
+    const int warmup_frames_count = 5;
+    for (int frame = 0; frame < warmup_frames_count + frames_count; frame++)
+    {
+        // Every context gets the same mouse events, as if each had its own platform backend
+        const ImVec2 mouse_pos((float)((frame * 37) % 1900), (float)((frame * 23) % 1000));
+        for (ImGuiContext* ctx : contexts)
+        {
+            ImGui::SetCurrentContext(ctx);
+            ImGui::GetIO().AddMousePosEvent(mouse_pos.x, mouse_pos.y);
+        }
+
+        const int allocs_before = g_allocs_count;
+        const double time_start = GetTimeSeconds();
+        double time_compositor = 0.0;
+        double t0 = GetTimeSeconds();
+        ImGuiMultiContextCompositor_PreNewFrameUpdateAll(&mcc);
+        time_compositor += GetTimeSeconds() - t0;
+        for (int ctx_n = 0; ctx_n < contexts.Size; ctx_n++)
+        {
+            ImGuiContext* ctx = contexts[ctx_n];
+            ImGui::SetCurrentContext(ctx);
+            ImGui::NewFrame();
+            t0 = GetTimeSeconds();
+            ImGuiMultiContextCompositor_PostNewFrameUpdateOne(&mcc, ctx);
+            time_compositor += GetTimeSeconds() - t0;
+            ImGui::SetNextWindowPos(ImVec2((float)(ctx_n * 29 % 1500), (float)(ctx_n * 17 % 700)), ImGuiCond_Once);
+            ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_Once);
+            char title[32];
+            snprintf(title, sizeof(title), "Context %d", ctx_n);
+            ImGui::Begin(title);
+            for (int n = 0; n < 20; n++)
+            {
+                ImGui::Button("Button");
+                ImGui::SameLine();
+                ImGui::Text("Item %d, frame %d", n, frame);
+            }
+            ImGui::End();
+            ImGui::Render();
+        }
+        if (merged_draw_data)
+        {
+            t0 = GetTimeSeconds();
+            ImGuiMultiContextCompositor_GetMergedDrawData(&mcc);
+            time_compositor += GetTimeSeconds() - t0;
+        }
+        t0 = GetTimeSeconds();
+        ImGuiMultiContextCompositor_PostEndFrameUpdateAll(&mcc);
+        time_compositor += GetTimeSeconds() - t0;
+        if (frame < warmup_frames_count)
+            continue;
+
+        results.FrameMs += (GetTimeSeconds() - time_start) * 1000.0;
+        results.AllocsCount += g_allocs_count - allocs_before;
+        compositor_ms += time_compositor * 1000.0;
+        for (ImGuiContext* ctx : contexts)
+        {
+            ImGui::SetCurrentContext(ctx);
+            results.VtxCount += ImGui::GetDrawData()->TotalVtxCount;
+        }
+    }
+    for (ImGuiContext* ctx : contexts)
+    {
+        ImGuiMultiContextCompositor_RemoveContext(&mcc, ctx);
+        ImGui::DestroyContext(ctx);
+    }
+    results.FrameMs /= frames_count;
+    results.VtxCount /= frames_count;
+    results.AllocsCount /= frames_count;
+    *out_compositor_ms = compositor_ms / frames_count;
+    return results;
+}
+
+static void BenchmarkCompositor(ImFontAtlas* atlas, int frames_count)
+{
+    const int contexts_counts[] = { 2, 4, 8, 16, 32, 64 };
+    printf("# Multi-context compositor (%d frames per configuration)\n", frames_count);
+    printf("%8s %6s %10s %14s %10s %10s\n", "contexts", "merged", "frame_ms", "compositor_ms", "vtx", "allocs");
+    for (int count_n = 0; count_n < IM_ARRAYSIZE(contexts_counts); count_n++)
+        for (int merged = 0; merged < 2; merged++)
+        {
+            double compositor_ms = 0.0;
+            FrameResults r = RunCompositor(atlas, contexts_counts[count_n], merged != 0, frames_count, &compositor_ms);
+            printf("%8d %6d %10.3f %14.3f %10.0f %10.1f\n", contexts_counts[count_n], merged, r.FrameMs, compositor_ms, r.VtxCount, r.AllocsCount);
+        }
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const int frames_count = (argc > 1) ? atoi(argv[1]) : 30;
+    const char* only = (argc > 2) ? argv[2] : NULL;
+    if (frames_count < 1)
+    {
+        printf("Usage: %s [frames_count] [memory_editor|compositor]\n", argv[0]);
+        return 1;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+
+    // Shared font atlas, built once
+    ImFontAtlas* atlas = IM_NEW(ImFontAtlas)();
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    if (only == NULL || strcmp(only, "memory_editor") == 0)
+        BenchmarkMemoryEditor(atlas, frames_count);
+    if (only == NULL || strcmp(only, "compositor") == 0)
+        BenchmarkCompositor(atlas, frames_count);
+
+    IM_DELETE(atlas);
+    return 0;
+}
@@ -49,17 +49,44 @@
 //                       fixed a data preview crash with 1.91.0 WIP. fixed contiguous highlight color when using data preview.
 //                       *BREAKING* added UserData field passed to all optional function handlers: ReadFn, WriteFn, HighlightFn, BgColorFn. (#50) [@silverweed]
 // - v0.56 (2024/11/04): fixed MouseHovered, MouseHoveredAddr not being set when hovering a byte being edited. (#54)
+// - v0.57 (2026/10/14): added ReadRangeFn optional handler to read visible rows with a single call. visible bytes are read once and shared by hex, ascii and data preview.
+//                       added RequestPageFn optional handler, SetPageData(), SetPageUnreadable(), InvalidatePages() for asynchronous paged memory sources. pending/unreadable bytes are displayed as ".."/"??".
+//                       pending pages not completed after OptPagePendingTimeoutFrames frames are requested again when visible, and may be evicted when not.
+//                       added OptFastRendering option to draw hex values directly into the ImDrawList, with a single hit test per line, instead of submitting one item per byte.
+//                       HighlightFn and BgColorFn are called once per visible byte. adjacent background colors are merged into a single rectangle.
+//                       added ColorRangesFn optional handler to provide background colors as sorted [Min, Max) ranges for the visible addresses.
+//                       added search bar (OptShowSearch) for hex patterns with wildcards (e.g. "DE AD ?? E?") and text. search is time-sliced over frames (OptSearchBytesPerFrame).
+//                       added SearchParallelForFn optional handler to scan direct memory over multiple threads using your job system. search progress and cancel button displayed in options line.
+//                       added OptShowChanges option to highlight bytes changed since previous frame, or since a pinned snapshot (PinChangesSnapshot()). only visible lines + OptChangesPrefetchLines are tracked.
+//                       pinned snapshot keeps bytes scrolled out of view, up to OptChangesPinMaxSize bytes.
+//                       added VisibleAddrMin, VisibleAddrMax public readable fields.
+//                       added compare view: SetCompareData() displays a second buffer side by side, differences are highlighted. blocks of OptCompareBlockSize bytes are compared over multiple frames so FindNextDiff() and Prev/Next buttons quickly skip identical blocks.
+//                       added virtual scrolling for large address spaces (more than OptVirtualScrollMinLines lines): lines are emitted from a 64-bit top line with a custom scrollbar, instead of relying on float scrolling over a huge contents height.
+//                       added SetRegions() to only display a sorted list of mapped regions (e.g. process address space). gaps are collapsed into a single line and never read.
+//                       added imgui_memory_editor_file.h: MemoryEditorFile data source to display large files through sliding mapped windows, with edits stored in an overlay.
+//                       added undo/redo journal (Undo(), Redo(), Ctrl+Z, Ctrl+Y). contiguous edits are merged into a single entry. journal size is limited by OptUndoMaxSize.
+//                       added WriteBytes() to write a range of bytes as a single undo entry, and WriteRangeFn optional handler to write a range with one call.
+//                       added range selection (mouse drag, shift+click) with SelectMin/SelectMax. copy as hex, C array or base64 (Ctrl+C, options menu), paste from any of those formats (Ctrl+V).
+//                       added struct overlays (AddStructOverlay()): typed fields at offsets of an address, colored in the grid, with values in a tooltip and a footer panel (OptShowStructs). decoded values are cached until their bytes change.
+//                       added minimap (OptShowMinimap) beside the scrolling area, showing entropy or zero/ascii/other bytes ratios of blocks of OptMinimapBlockSize bytes. blocks are computed over multiple frames, written blocks are computed again. click to jump.
+//                       added GetSizes() returning layout cached until font, style, Cols, options or mem_size change. DrawWindow() and DrawContents() don't call CalcSizes() every frame anymore.
+//                       fixed DrawWindow() resizing the window every frame after columns or ascii option were changed once.
+//                       added OptNibbleEditing option to edit bytes without InputText(): typed hex digits are applied to nibbles directly, many per frame. added PageUp/PageDown navigation.
+//                       added Stats public readable field filled by DrawContents(): lines/bytes drawn, handlers calls, vertices/indices added, time spent in each section (GetTimeFn optional handler). added OptShowStatsOverlay to display them.
+//                       added imgui_memory_editor_shared.h: MemoryEditorShared data source for multiple editors viewing the same target, merging their visible ranges into batched reads through a shared page cache. added VisibleFrame public readable field.
+//                       added watches (AddWatch()): typed values read by UpdateWatches() once per frame, even when contents are not drawn. neighbor watches are read with a single call. WatchChangedFn optional handler is called on change, watched bytes are highlighted in the grid and listed in a footer panel (OptShowWatches).
+//                       added OptDisplayMode: DisplayMode_Words displays columns of PreviewDataType values (e.g. u16/u32/float), DisplayMode_Pixels displays dense colored cells (OptPixelFormat, OptPixelSize) with runs of same color merged into a single rectangle.
 //
 // TODO:
 // - This is generally old/crappy code, it should work but isn't very good.. to be rewritten some day.
-// - PageUp/PageDown are not supported because we use _NoNav. This is a good test scenario for working out idioms of how to mix natural nav and our own...
 // - Arrows are being sent to the InputText() about to disappear which for LeftArrow makes the text cursor appear at position 1 for one frame.
-// - Using InputText() is awkward and maybe overkill here, consider implementing something custom.
+// - Using InputText() is awkward and maybe overkill here, consider making OptNibbleEditing the default.
 
 #pragma once
 
 #include <stdio.h>      // sprintf, scanf
 #include <stdint.h>     // uint8_t, etc.
+#include <math.h>       // logf
 
 #if defined(_MSC_VER) || defined(_UCRT)
 #define _PRISizeT   "I"
@@ -84,6 +111,115 @@ struct MemoryEditor
         DataFormat_COUNT
     };
 
+    struct ColorRange
+    {
+        size_t          Min, Max;                               // [Min, Max) address range
+        ImU32           Color;
+    };
+
+    enum RegionFlags
+    {
+        RegionFlags_None        = 0,
+        RegionFlags_Unreadable  = 1 << 0,                       // e.g. guard pages: displayed but never read.
+        RegionFlags_ReadOnly    = 1 << 1,                       // never written.
+    };
+
+    struct Region
+    {
+        size_t          Addr;
+        size_t          Size;
+        int             Flags;                                  // RegionFlags_XXX
+    };
+
+    enum CopyFormat
+    {
+        CopyFormat_Hex,                                         // "DE AD BE EF"
+        CopyFormat_CArray,                                      // "0xDE, 0xAD, 0xBE, 0xEF"
+        CopyFormat_Base64,                                      // "3q2+7w=="
+        CopyFormat_COUNT
+    };
+
+    struct StructField
+    {
+        const char*     Name;                                   // pointer is stored, must stay valid (e.g. string literal)
+        size_t          Offset;                                 // offset from overlay address
+        ImGuiDataType   DataType;
+        ImU32           Color;                                  // background color in grid. 0 to use StructFieldColor.
+    };
+
+    struct Watch
+    {
+        int             ID;                                     // returned by AddWatch()
+        const char*     Name;                                   // pointer is stored, must stay valid (e.g. string literal). may be NULL.
+        size_t          Addr;
+        ImGuiDataType   DataType;
+        bool            Valid;                                  // Value was read at least once
+        ImU8            Value[8];                               // bytes read by last UpdateWatches() call
+        int             ChangesCount;                           // number of changes detected since added
+        int             ChangedFrame;                           // frame count of last change, or -1
+        double          ChangedTime;                            // ImGui::GetTime() of last change, or -1.0
+    };
+
+    enum MinimapMode
+    {
+        MinimapMode_Entropy = 0,                                // from dark blue (constant bytes) to red (random or compressed bytes)
+        MinimapMode_Classes = 1,                                // ratios of zero (grey), ascii (blue) and other (orange) bytes
+        MinimapMode_COUNT
+    };
+
+    enum DisplayMode
+    {
+        DisplayMode_Hex = 0,                                    // hexadecimal bytes
+        DisplayMode_Words = 1,                                  // values of PreviewDataType decoded with PreviewEndianness (e.g. u16/u32/float columns)
+        DisplayMode_Pixels = 2,                                 // one colored cell per byte or word (OptPixelFormat), without addresses
+        DisplayMode_COUNT
+    };
+
+    enum PixelFormat
+    {
+        PixelFormat_Gray8 = 0,                                  // one byte per cell, from black (0x00) to white (0xFF)
+        PixelFormat_Classes8 = 1,                               // one byte per cell: zero (grey), ascii (blue) and other (orange) bytes
+        PixelFormat_RGBA32 = 2,                                 // four bytes per cell in R, G, B, A order. alpha is ignored.
+        PixelFormat_COUNT
+    };
+
+    enum SearchMode
+    {
+        SearchMode_Hex = 0,                                     // hexadecimal bytes, '?' for wildcard nibbles. e.g. "DE AD ?? E?"
+        SearchMode_Text = 1,
+        SearchMode_COUNT
+    };
+
+    enum ByteStatus
+    {
+        ByteStatus_Ok = 0,
+        ByteStatus_Pending = 1,                                 // waiting for a page requested with RequestPageFn
+        ByteStatus_Unreadable = 2
+    };
+
+    // Statistics of last DrawContents() call
+    struct ContentsStats
+    {
+        int             LinesDrawn;
+        size_t          BytesDrawn;
+        int             ReadFnCalls;
+        int             ReadRangeFnCalls;
+        int             RequestPageFnCalls;
+        int             HighlightFnCalls;
+        int             BgColorFnCalls;
+        int             ColorRangesFnCalls;
+        int             VtxCount;                               // vertices added to draw lists (contents window, scrolling child)
+        int             IdxCount;                               // indices added to draw lists
+        float           TimeUpdate;                             // milliseconds (times require GetTimeFn) spent in background passes (search, compare, changes)
+        float           TimeGrid;                               // milliseconds spent in lines, excluding ascii (address, background colors, hexadecimal, compare)
+        float           TimeAscii;                              // milliseconds spent in ascii column
+        float           TimeMinimap;                            // milliseconds spent updating and drawing minimap
+        float           TimeFooter;                             // milliseconds spent in options, search, data preview and structs lines
+        float           TimeTotal;                              // milliseconds spent in DrawContents()
+
+        ContentsStats() { memset(this, 0, sizeof(*this)); }
+    };
+
     // Settings
     bool            Open;                                       // = true   // set to false when DrawWindow() was closed. ignore if not using DrawWindow().
     bool            ReadOnly;                                   // = false  // disable any editing.
@@ -94,21 +230,69 @@ struct MemoryEditor
     bool            OptShowAscii;                               // = true   // display ASCII representation on the right side.
     bool            OptGreyOutZeroes;                           // = true   // display null/zero bytes using the TextDisabled color.
     bool            OptUpperCaseHex;                            // = true   // display hexadecimal values as "FF" instead of "ff".
+    bool            OptShowSearch;                              // = false  // display search bar.
+    bool            OptShowMinimap;                             // = false  // display a minimap of the whole memory on the right side. click to jump.
+    bool            OptShowStructs;                             // = false  // display a footer listing values of struct overlay fields in the visible range.
+    bool            OptShowWatches;                             // = false  // display a footer listing watches values (see AddWatch()).
+    bool            OptShowChanges;                             // = false  // highlight bytes which changed since previous frame (fading out) or since pinned snapshot. only visible lines are tracked.
+    bool            OptFastRendering;                           // = false  // draw hexadecimal values directly with ImDrawList + a single hit test per line, instead of submitting one item per byte. much faster with many visible bytes.
+    bool            OptShowStatsOverlay;                        // = false  // display Stats in an overlay at the top-right of the contents.
+    bool            OptNibbleEditing;                           // = false  // edit bytes with a lightweight editor handling typed hex digits directly, instead of an InputText(). fast typing may edit many bytes per frame.
+    int             OptDisplayMode;                             // = DisplayMode_Hex // display bytes as hexadecimal, words or pixels. editing is only available in hexadecimal mode.
+    int             OptPixelFormat;                             // = PixelFormat_Gray8 // with DisplayMode_Pixels. Cols is the number of bytes per line (e.g. the pitch of a texture).
+    int             OptPixelSize;                               // = 4      // width and height of cells in pixels, with DisplayMode_Pixels.
     int             OptMidColsCount;                            // = 8      // set to 0 to disable extra spacing between every mid-cols.
     int             OptAddrDigitsCount;                         // = 0      // number of addr digits to display (default calculated based on maximum displayed addr).
     float           OptFooterExtraHeight;                       // = 0      // space to reserve at the bottom of the widget to add custom widgets
+    size_t          OptPageSize;                                // = 4096   // size of pages requested with RequestPageFn.
+    int             OptPagePrefetchCount;                       // = 4      // number of pages requested before and after the visible range when using RequestPageFn.
+    int             OptPageCacheMaxCount;                       // = 256    // maximum number of pages kept in cache when using RequestPageFn.
+    int             OptPagePendingTimeoutFrames;                // = 60     // pending pages are requested again when still visible after this number of frames, and may be evicted when unused for as long. 0 to wait forever.
+    size_t          OptSearchBytesPerFrame;                     // = 16 MB  // maximum number of bytes scanned by search every frame.
+    int             OptSearchMaxResults;                        // = 100000 // search stops after this number of results.
+    size_t          OptVirtualScrollMinLines;                   // = 1000000 // use virtual scrolling when there are more lines than this (always used above 2^31 lines). set to 0 to always use.
+    int             OptChangesPrefetchLines;                    // = 16     // number of lines tracked above and below visible lines, when OptShowChanges is set.
+    float           OptChangesFadeTime;                         // = 1.0f   // time for highlight of changed bytes to fade out, in seconds.
+    size_t          OptChangesPinMaxSize;                       // = 16 MB  // maximum size of pinned snapshot. once reached, bytes scrolled out of view are compared to their value when tracked again.
+    size_t          OptCompareBlockSize;                        // = 4096   // granularity of block differences used to skip identical data in compare view.
+    size_t          OptCompareBytesPerFrame;                    // = 64 MB  // maximum number of bytes compared by block scan every frame.
+    int             OptMinimapMode;                             // = MinimapMode_Entropy
+    size_t          OptMinimapBlockSize;                        // = 64 KB  // bytes summarized by each minimap block. larger blocks are used when there would be more than MinimapMaxBlocks blocks, and are sampled.
+    size_t          OptMinimapBytesPerFrame;                    // = 64 MB  // maximum number of bytes read by minimap every frame.
+    size_t          OptUndoMaxSize;                             // = 64 MB  // maximum size of the undo journal. oldest entries are discarded when exceeded.
+    int             OptStructsPanelLines;                       // = 6      // number of lines of struct fields panel, when OptShowStructs is set.
+    int             OptWatchesPanelLines;                       // = 6      // number of lines of watches panel, when OptShowWatches is set.
+    size_t          OptWatchesMergeGap;                         // = 64     // watches separated by less than this number of bytes are read with a single call.
+    int             OptSearchJobsCount;                         // = 8      // number of jobs scanning OptSearchBytesPerFrame bytes each per frame, when using SearchParallelForFn. max SearchJobsMaxCount.
     ImU32           HighlightColor;                             //          // background color of highlighted bytes.
+    ImU32           SearchResultColor;                          //          // background color of search results.
+    ImU32           ChangedColor;                               //          // background color of changed bytes (alpha is faded out over time).
+    ImU32           CompareDiffColor;                           //          // background color of bytes which differ from compare data.
+    ImU32           StructFieldColor;                           //          // background color of struct overlay fields. every other field uses half alpha.
+    ImU32           WatchColor;                                 //          // background color of watched bytes. ChangedColor is used (fading out) after a change.
 
     // Function handlers
     ImU8            (*ReadFn)(const ImU8* mem, size_t off, void* user_data);      // = 0      // optional handler to read bytes.
+    void            (*ReadRangeFn)(const ImU8* mem, size_t off, ImU8* out_buf, size_t size, void* user_data); // = 0 // optional handler to read a range of bytes (visible rows are read with one call). takes precedence over ReadFn.
     void            (*WriteFn)(ImU8* mem, size_t off, ImU8 d, void* user_data);   // = 0      // optional handler to write bytes.
+    void            (*WriteRangeFn)(ImU8* mem, size_t off, const ImU8* buf, size_t size, void* user_data); // = 0 // optional handler to write a range of bytes (e.g. pasted data is written with one call). takes precedence over WriteFn.
     bool            (*HighlightFn)(const ImU8* mem, size_t off, void* user_data); // = 0      // optional handler to return Highlight property (to support non-contiguous highlighting).
     ImU32           (*BgColorFn)(const ImU8* mem, size_t off, void* user_data);   // = 0      // optional handler to return custom background color of individual bytes.
+    void            (*ColorRangesFn)(const ImU8* mem, size_t addr_min, size_t addr_max, ImVector<ColorRange>* out_ranges, void* user_data); // = 0 // optional handler to output sorted, non-overlapping background color ranges intersecting [addr_min, addr_max). called once per clipper step. BgColorFn is only called for bytes not covered by a range.
+    void            (*SearchParallelForFn)(void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count, void* user_data); // = 0 // optional handler to call job_fn(job_data, 0..jobs_count-1) in parallel and return once they are all done. used to search direct memory (not used with ReadFn/ReadRangeFn).
+    void            (*RequestPageFn)(const ImU8* mem, size_t page_addr, size_t page_size, void* user_data); // = 0 // optional non-blocking handler to request a page. complete it later by calling SetPageData() or SetPageUnreadable(). takes precedence over ReadRangeFn/ReadFn.
+    void            (*WatchChangedFn)(const ImU8* mem, const Watch& watch, const ImU8* old_value, void* user_data); // = 0 // optional handler called by UpdateWatches() when a watched value changed. watch.Value holds the new value.
+    double          (*GetTimeFn)(void* user_data);                                // = 0      // optional handler returning current time in seconds from a high resolution clock. Stats times are only measured when set.
     void*           UserData;                                                     // = NULL   // user data forwarded to the function handlers
 
     // Public read-only data
     bool            MouseHovered;                               // set when mouse is hovering a value.
     size_t          MouseHoveredAddr;                           // the address currently being hovered if MouseHovered is set.
+    size_t          VisibleAddrMin, VisibleAddrMax;             // [min, max) range of addresses visible during last DrawContents() call.
+    int             VisibleFrame;                               // frame count of last DrawContents() call.
+    size_t          SelectMin, SelectMax;                       // [min, max) range of selected addresses. may be set with SelectRange().
+    bool            LastWriteUndoable;                          // false when last WriteBytes() call was too large to be recorded in undo journal.
+    mutable ContentsStats Stats;                                // statistics of last DrawContents() call. mutable so read counters can be updated from const read functions.
 
     // [Internal State]
     bool            ContentsWidthChanged;
@@ -116,11 +300,142 @@ struct MemoryEditor
     size_t          DataEditingAddr;
     bool            DataEditingTakeFocus;
     char            DataInputBuf[32];
+    size_t          DataEditingLowNibbleAddr;                   // OptNibbleEditing: low nibble of DataEditingAddr is edited when equal to it, otherwise high nibble
     char            AddrInputBuf[32];
     size_t          GotoAddr;
     size_t          HighlightMin, HighlightMax;
+    size_t          SelectAnchorAddr;                           // address where selection started
+    bool            SelectDragging;
+    int             CopyFormatDefault;                          // CopyFormat_XXX used by Ctrl+C and last copy
+    ImU32           ClipboardCopyHash;                          // hash of text of last copy, pasting it back uses CopyFormatDefault instead of guessing format
+    size_t          ClipboardCopyLen;
+    ImVector<char>  ClipboardBuf;
+    ImVector<ImU8>  ClipboardChunkBuf;
+    ImVector<ImU8>  PasteBuf;
     int             PreviewEndianness;
     ImGuiDataType   PreviewDataType;
+    ImVector<ImU8>  ReadBuf;                                    // copy of visible bytes when using ReadFn/ReadRangeFn/RequestPageFn, valid during DrawContents()
+    ImVector<ImU8>  ReadBufStatus;                              // ByteStatus of each byte in ReadBuf
+    size_t          ReadBufAddr;
+
+    struct PageEntry
+    {
+        size_t      Addr;
+        int         Status;                                     // ByteStatus_Pending, ByteStatus_Ok or ByteStatus_Unreadable
+        int         Slot;                                       // index of page data in PagesData when Status == ByteStatus_Ok
+        int         LastUsedFrame;
+        int         RequestFrame;                               // frame of last RequestPageFn call for this page
+    };
+    char            SearchInputBuf[256];
+    int             SearchInputMode;                            // SearchMode
+    ImVector<ImU8>  SearchPattern;                              // pattern bytes, pre-masked
+    ImVector<ImU8>  SearchMask;                                 // bits to compare for each pattern byte
+    ImVector<size_t> SearchResults;                             // sorted addresses of results found so far
+    ImVector<ImU8>  SearchChunkBuf;
+    size_t          SearchScanAddr;                             // next address to scan
+    size_t          SearchMemSize;                              // mem_size at the time the search started
+    bool            SearchActive;                               // scan in progress
+
+    struct SearchJob
+    {
+        const ImU8*     MemData;
+        size_t          ScanAddr;                               // scan [ScanAddr, ScanAddr + ScanCount) start addresses
+        size_t          ScanCount;
+        int             MaxResults;
+        ImVector<size_t> Results;
+    };
+    enum { SearchJobsMaxCount = 32 };
+    SearchJob       SearchJobs[SearchJobsMaxCount];
+    ImVector<Region> Regions;                                   // set with SetRegions(), sorted by Addr
+    struct RegionLines
+    {
+        size_t          AddrLineMin, AddrLineMax;               // [min, max) range of address lines (addr / Cols) displayed, merging regions sharing lines
+        size_t          LineMin;                                // first displayed line. regions after the first one are preceded by a gap line.
+    };
+    ImVector<RegionLines> RegionsLines;                         // built from Regions for current Cols and mem_size
+    int             RegionLinesCols;
+    size_t          RegionLinesMemSize;
+    bool            VirtualScroll;                              // virtual scrolling was used by last DrawContents() call
+    size_t          VirtualScrollTopLine;                       // first visible line when using virtual scrolling
+    size_t          VirtualScrollLinesCount;                    // number of fully visible lines when using virtual scrolling
+    const ImU8*     CompareMemData;                             // set with SetCompareData()
+    size_t          CompareMemSize;
+    ImVector<ImU8>  CompareBlocks;                              // CompareBlock_XXX status for each block of OptCompareBlockSize bytes
+    int             CompareScanBlock;                           // next block to be compared by UpdateCompareBlocks()
+    ImVector<ImU8>  CompareChunkBuf;
+    enum { MinimapMaxBlocks = 65536 };
+    enum { MinimapBlock_Unknown = 0, MinimapBlock_Valid = 1, MinimapBlock_Unmapped = 2 };
+    struct MinimapBlock
+    {
+        ImU8            Status;                                 // MinimapBlock_XXX
+        ImU8            Entropy;                                // 0..255 for 0..8 bits per byte
+        ImU8            Zero, Ascii;                            // 0..255 ratios of zero and ascii bytes. other bytes are 255 - Zero - Ascii.
+    };
+    ImVector<MinimapBlock> MinimapBlocks;
+    size_t          MinimapBlockSize;                           // block size used by MinimapBlocks
+    size_t          MinimapMemSize;
+    int             MinimapScanBlock;                           // first block which may need to be computed
+    ImVector<ImU8>  MinimapChunkBuf;
+    struct UndoEntry
+    {
+        size_t          Addr;
+        size_t          Size;
+        size_t          DataOffset;                             // offset in UndoData of Size interleaved (old value, new value) pairs
+    };
+    ImVector<UndoEntry> UndoEntries;
+    ImVector<ImU8>  UndoData;                                   // shared storage of all entries, in entries order
+    ImVector<ImU8>  UndoScratch;
+    int             UndoCount;                                  // number of applied entries. entries after it can be redone.
+    bool            UndoMergeAllowed;                           // next contiguous write may be appended to last entry
+    enum { ChangesMaxVisibleLines = 256 };
+    enum { ChangesPinBlockSize = 4096 };
+    enum { CompareBlock_Unknown = 0, CompareBlock_Equal = 1, CompareBlock_Different = 2 };
+    size_t          ChangesAddr;                                // first address of tracked range
+    ImVector<ImU8>  ChangesShadow;                              // previous frame (or pinned snapshot) values of tracked range
+    ImVector<ImU8>  ChangesHeat;                                // 255 when changed, fading out to 0
+    ImVector<ImU8>  ChangesScratch;
+    struct ChangesPinBlock
+    {
+        size_t          Addr;                                   // multiple of ChangesPinBlockSize
+        int             Size;                                   // ChangesPinBlockSize, or less at end of memory
+        int             DataOffset;                             // offset in ChangesPinData[]
+    };
+    ImVector<ChangesPinBlock> ChangesPinBlocks;                 // pinned snapshot of all blocks tracked since pinning, sorted by address
+    ImVector<ImU8>  ChangesPinData;
+    float           ChangesFadeAccum;
+    bool            ChangesPinned;
+    struct StructOverlay
+    {
+        const char*     Name;
+        size_t          Addr;
+        int             FieldsIndex;                            // first field in StructFields
+        int             FieldsCount;
+    };
+    struct StructFieldSpan
+    {
+        size_t          Addr;                                   // absolute address of field
+        int             FieldIndex;                             // in StructFields
+        int             OverlayIndex;                           // in StructOverlays
+        bool            Decoded;                                // Raw and Value are valid for DecodedEndianness
+        int             DecodedEndianness;
+        ImU8            Raw[8];                                 // bytes Value was decoded from
+        char            Value[64];
+    };
+    ImVector<StructOverlay> StructOverlays;
+    ImVector<StructField> StructFields;
+    ImVector<StructFieldSpan> StructSpans;                      // one per field, sorted by Addr
+    ImVector<int>   StructVisibleSpans;                         // spans intersecting visible addresses, rebuilt every frame when OptShowStructs is set
+    ImVector<Watch> Watches;                                    // sorted by Addr
+    ImVector<ImU8>  WatchesReadBuf;
+    ImVector<ImU8>  WatchesReadStatus;                          // ByteStatus of each byte in WatchesReadBuf
+    int             WatchesNextID;
+    int             WatchesUpdateFrame;                         // frame count of last UpdateWatches() call
+    ImVector<ColorRange> ColorRanges;                           // output of ColorRangesFn for the visible addresses
+    ImVector<ImU32> LineBgColors;                               // [Cols * 3] background colors of hex, ascii and compare cells for the line being drawn
+    ImVector<ImU32> LinePixelColors;                            // colors of cells for the line being drawn, with DisplayMode_Pixels
+    ImVector<PageEntry> Pages;                                  // pages requested with RequestPageFn, sorted by Addr
+    ImVector<ImU8>  PagesData;                                  // OptPageCacheMaxCount * OptPageSize bytes
+    ImVector<int>   PagesFreeSlots;
 
     MemoryEditor()
     {
@@ -134,28 +449,102 @@ struct MemoryEditor
         OptShowAscii = true;
         OptGreyOutZeroes = true;
         OptUpperCaseHex = true;
+        OptShowSearch = false;
+        OptShowMinimap = false;
+        OptShowStructs = false;
+        OptShowWatches = false;
+        OptShowChanges = false;
+        OptFastRendering = false;
+        OptNibbleEditing = false;
+        OptShowStatsOverlay = false;
+        OptDisplayMode = DisplayMode_Hex;
+        OptPixelFormat = PixelFormat_Gray8;
+        OptPixelSize = 4;
         OptMidColsCount = 8;
         OptAddrDigitsCount = 0;
         OptFooterExtraHeight = 0.0f;
+        OptPageSize = 4096;
+        OptPagePrefetchCount = 4;
+        OptPageCacheMaxCount = 256;
+        OptPagePendingTimeoutFrames = 60;
+        OptSearchBytesPerFrame = 16 * 1024 * 1024;
+        OptSearchMaxResults = 100000;
+        OptSearchJobsCount = 8;
+        OptStructsPanelLines = 6;
+        OptWatchesPanelLines = 6;
+        OptWatchesMergeGap = 64;
+        OptVirtualScrollMinLines = 1000000;
+        OptChangesPrefetchLines = 16;
+        OptChangesFadeTime = 1.0f;
+        OptChangesPinMaxSize = 16 * 1024 * 1024;
+        OptCompareBlockSize = 4096;
+        OptCompareBytesPerFrame = 64 * 1024 * 1024;
+        OptMinimapMode = MinimapMode_Entropy;
+        OptMinimapBlockSize = 64 * 1024;
+        OptMinimapBytesPerFrame = 64 * 1024 * 1024;
+        OptUndoMaxSize = 64 * 1024 * 1024;
         HighlightColor = IM_COL32(255, 255, 255, 50);
+        SearchResultColor = IM_COL32(255, 200, 0, 70);
+        ChangedColor = IM_COL32(255, 40, 40, 180);
+        CompareDiffColor = IM_COL32(255, 0, 255, 80);
+        StructFieldColor = IM_COL32(0, 160, 255, 60);
+        WatchColor = IM_COL32(0, 255, 120, 50);
         ReadFn = nullptr;
+        ReadRangeFn = nullptr;
         WriteFn = nullptr;
+        WriteRangeFn = nullptr;
         HighlightFn = nullptr;
         BgColorFn = nullptr;
+        ColorRangesFn = nullptr;
+        SearchParallelForFn = nullptr;
+        RequestPageFn = nullptr;
+        WatchChangedFn = nullptr;
+        GetTimeFn = nullptr;
         UserData = nullptr;
 
         // State/Internals
         ContentsWidthChanged = false;
         DataPreviewAddr = DataEditingAddr = (size_t)-1;
         DataEditingTakeFocus = false;
+        DataEditingLowNibbleAddr = (size_t)-1;
         memset(DataInputBuf, 0, sizeof(DataInputBuf));
         memset(AddrInputBuf, 0, sizeof(AddrInputBuf));
         GotoAddr = (size_t)-1;
         MouseHovered = false;
         MouseHoveredAddr = 0;
+        VisibleAddrMin = VisibleAddrMax = 0;
+        VisibleFrame = -1;
         HighlightMin = HighlightMax = (size_t)-1;
+        SelectMin = SelectMax = SelectAnchorAddr = (size_t)-1;
+        SelectDragging = false;
+        CopyFormatDefault = CopyFormat_Hex;
+        ClipboardCopyHash = 0;
+        ClipboardCopyLen = (size_t)-1;
         PreviewEndianness = 0;
         PreviewDataType = ImGuiDataType_S32;
+        ReadBufAddr = 0;
+        memset(SearchInputBuf, 0, sizeof(SearchInputBuf));
+        SearchInputMode = SearchMode_Hex;
+        SearchScanAddr = SearchMemSize = 0;
+        SearchActive = false;
+        RegionLinesCols = 0;
+        RegionLinesMemSize = 0;
+        VirtualScroll = false;
+        VirtualScrollTopLine = 0;
+        VirtualScrollLinesCount = 1;
+        CompareMemData = NULL;
+        CompareMemSize = 0;
+        CompareScanBlock = 0;
+        MinimapBlockSize = MinimapMemSize = 0;
+        MinimapScanBlock = 0;
+        UndoCount = 0;
+        UndoMergeAllowed = false;
+        LastWriteUndoable = true;
+        ChangesAddr = 0;
+        ChangesFadeAccum = 0.0f;
+        ChangesPinned = false;
+        WatchesNextID = 0;
+        WatchesUpdateFrame = -1;
     }
 
     void GotoAddrAndHighlight(size_t addr_min, size_t addr_max)
@@ -176,11 +565,77 @@ struct MemoryEditor
         float   PosHexEnd;
         float   PosAsciiStart;
         float   PosAsciiEnd;
+        float   PosCompareStart;
+        float   PosCompareEnd;
+        float   MinimapWidth;
         float   WindowWidth;
+        const char* FormatAddress;                              // "%0*zX: "
+        const char* FormatData;                                 // "%0*zX"
+        const char* FormatByte;                                 // "%02X"
+        const char* FormatByteSpace;                            // "%02X "
 
         Sizes() { memset(this, 0, sizeof(*this)); }
     };
 
+    // [Internal] Inputs of CalcSizes(), compared with memcmp()
+    struct SizesKey
+    {
+        ImFont*         Font;
+        float           FontSize;
+        float           ScrollbarSize;
+        float           WindowPaddingX;
+        float           ItemSpacingX;
+        size_t          MemSize;
+        size_t          BaseDisplayAddr;
+        int             Cols;
+        int             MidColsCount;
+        int             AddrDigitsCount;
+        bool            ShowAscii;
+        bool            ShowMinimap;
+        bool            ShowCompare;
+        bool            UpperCaseHex;
+        int             DisplayMode;
+        int             PixelFormat;
+        int             PixelSize;
+        ImGuiDataType   WordsDataType;
+
+        SizesKey() { memset(this, 0, sizeof(*this)); }
+    };
+    Sizes           CachedSizes;                                // [Internal] returned by GetSizes()
+    SizesKey        CachedSizesKey;
+
+    // Return layout for given mem_size/base_display_addr, only calling CalcSizes() when one of its inputs changed.
+    // Valid until next call. May be used for custom drawing in footer (see OptFooterExtraHeight).
+    const Sizes& GetSizes(size_t mem_size, size_t base_display_addr)
+    {
+        ImGuiStyle& style = ImGui::GetStyle();
+        SizesKey key;
+        key.Font = ImGui::GetFont();
+        key.FontSize = ImGui::GetFontSize();
+        key.ScrollbarSize = style.ScrollbarSize;
+        key.WindowPaddingX = style.WindowPadding.x;
+        key.ItemSpacingX = style.ItemSpacing.x;
+        key.MemSize = mem_size;
+        key.BaseDisplayAddr = base_display_addr;
+        key.Cols = Cols;
+        key.MidColsCount = OptMidColsCount;
+        key.AddrDigitsCount = OptAddrDigitsCount;
+        key.ShowAscii = OptShowAscii;
+        key.ShowMinimap = OptShowMinimap;
+        key.ShowCompare = (CompareMemData != NULL);
+        key.UpperCaseHex = OptUpperCaseHex;
+        key.DisplayMode = OptDisplayMode;
+        key.PixelFormat = (OptDisplayMode == DisplayMode_Pixels) ? OptPixelFormat : 0;
+        key.PixelSize = (OptDisplayMode == DisplayMode_Pixels) ? OptPixelSize : 0;
+        key.WordsDataType = (OptDisplayMode == DisplayMode_Words) ? PreviewDataType : 0;
+        if (memcmp(&key, &CachedSizesKey, sizeof(key)) != 0)
+        {
+            CachedSizesKey = key;
+            CalcSizes(CachedSizes, mem_size, base_display_addr);
+        }
+        return CachedSizes;
+    }
+
     void CalcSizes(Sizes& s, size_t mem_size, size_t base_display_addr)
     {
         ImGuiStyle& style = ImGui::GetStyle();
@@ -193,25 +648,82 @@ struct MemoryEditor
         s.HexCellWidth = (float)(int)(s.GlyphWidth * 2.5f);             // "FF " we include trailing space in the width to easily catch clicks everywhere
         s.SpacingBetweenMidCols = (float)(int)(s.HexCellWidth * 0.25f); // Every OptMidColsCount columns we add a bit of extra spacing
         s.PosHexStart = (s.AddrDigitsCount + 2) * s.GlyphWidth;
+        if (OptDisplayMode == DisplayMode_Words)
+        {
+            // Cells are sized for a word, each byte takes a fraction of it
+            const int word_size = (int)DataTypeGetSize(PreviewDataType);
+            s.HexCellWidth = s.GlyphWidth * (GetWordCharsCount(PreviewDataType) + 1) / word_size;
+            if (OptMidColsCount > 0 && OptMidColsCount % word_size != 0)
+                s.SpacingBetweenMidCols = 0.0f;
+        }
+        else if (OptDisplayMode == DisplayMode_Pixels)
+        {
+            // No address, ascii or compare columns
+            s.LineHeight = (float)(OptPixelSize > 1 ? OptPixelSize : 1);
+            s.HexCellWidth = s.LineHeight / GetPixelFormatSize(OptPixelFormat);
+            s.SpacingBetweenMidCols = 0.0f;
+            s.PosHexStart = 0.0f;
+        }
         s.PosHexEnd = s.PosHexStart + (s.HexCellWidth * Cols);
         s.PosAsciiStart = s.PosAsciiEnd = s.PosHexEnd;
-        if (OptShowAscii)
+        if (OptShowAscii && OptDisplayMode != DisplayMode_Pixels)
         {
             s.PosAsciiStart = s.PosHexEnd + s.GlyphWidth * 1;
             if (OptMidColsCount > 0)
                 s.PosAsciiStart += (float)((Cols + OptMidColsCount - 1) / OptMidColsCount) * s.SpacingBetweenMidCols;
             s.PosAsciiEnd = s.PosAsciiStart + Cols * s.GlyphWidth;
         }
-        s.WindowWidth = s.PosAsciiEnd + style.ScrollbarSize + style.WindowPadding.x * 2 + s.GlyphWidth;
+        s.PosCompareStart = s.PosCompareEnd = s.PosAsciiEnd;
+        if (CompareMemData && OptDisplayMode == DisplayMode_Hex)
+        {
+            s.PosCompareStart = s.PosAsciiEnd + s.GlyphWidth * 2;
+            s.PosCompareEnd = s.PosCompareStart + (s.PosHexEnd - s.PosHexStart);
+            if (OptMidColsCount > 0)
+                s.PosCompareEnd += (float)((Cols - 1) / OptMidColsCount) * s.SpacingBetweenMidCols;
+        }
+        s.MinimapWidth = OptShowMinimap ? s.GlyphWidth * 3 : 0.0f;
+        s.WindowWidth = s.PosCompareEnd + style.ScrollbarSize + style.WindowPadding.x * 2 + s.GlyphWidth;
+        if (OptShowMinimap)
+            s.WindowWidth += s.MinimapWidth + style.ItemSpacing.x;
+        s.FormatAddress = OptUpperCaseHex ? "%0*" _PRISizeT "X: " : "%0*" _PRISizeT "x: ";
+        s.FormatData = OptUpperCaseHex ? "%0*" _PRISizeT "X" : "%0*" _PRISizeT "x";
+        s.FormatByte = OptUpperCaseHex ? "%02X" : "%02x";
+        s.FormatByteSpace = OptUpperCaseHex ? "%02X " : "%02x ";
+    }
+
+    // Position of a hex column, relative to the start of a line
+    float GetHexCellPosX(const Sizes& s, int n) const
+    {
+        float byte_pos_x = s.PosHexStart + s.HexCellWidth * n;
+        if (OptMidColsCount > 0)
+            byte_pos_x += (float)(n / OptMidColsCount) * s.SpacingBetweenMidCols;
+        return byte_pos_x;
+    }
+
+    // Hex column under a given offset from s.PosHexStart (mid-cols spacing is attributed to the column on its left)
+    int GetHexCellFromOffsetX(const Sizes& s, float off_x) const
+    {
+        int n;
+        if (OptMidColsCount > 0)
+        {
+            const float group_width = s.HexCellWidth * OptMidColsCount + s.SpacingBetweenMidCols;
+            const int group_n = (int)(off_x / group_width);
+            const int n_in_group = (int)((off_x - group_n * group_width) / s.HexCellWidth);
+            n = group_n * OptMidColsCount + (n_in_group < OptMidColsCount ? n_in_group : OptMidColsCount - 1);
+        }
+        else
+        {
+            n = (int)(off_x / s.HexCellWidth);
+        }
+        return (n < Cols) ? n : Cols - 1;
     }
 
     // Standalone Memory Editor window
     void DrawWindow(const char* title, void* mem_data, size_t mem_size, size_t base_display_addr = 0x0000)
     {
-        Sizes s;
-        CalcSizes(s, mem_size, base_display_addr);
-        ImGui::SetNextWindowSize(ImVec2(s.WindowWidth, s.WindowWidth * 0.60f), ImGuiCond_FirstUseEver);
-        ImGui::SetNextWindowSizeConstraints(ImVec2(0.0f, 0.0f), ImVec2(s.WindowWidth, FLT_MAX));
+        const float window_width = GetSizes(mem_size, base_display_addr).WindowWidth;
+        ImGui::SetNextWindowSize(ImVec2(window_width, window_width * 0.60f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSizeConstraints(ImVec2(0.0f, 0.0f), ImVec2(window_width, FLT_MAX));
 
         Open = true;
         if (ImGui::Begin(title, &Open, ImGuiWindowFlags_NoScrollbar))
@@ -219,8 +731,8 @@ struct MemoryEditor
             DrawContents(mem_data, mem_size, base_display_addr);
             if (ContentsWidthChanged)
             {
-                CalcSizes(s, mem_size, base_display_addr);
-                ImGui::SetWindowSize(ImVec2(s.WindowWidth, ImGui::GetWindowSize().y));
+                ImGui::SetWindowSize(ImVec2(GetSizes(mem_size, base_display_addr).WindowWidth, ImGui::GetWindowSize().y));
+                ContentsWidthChanged = false;
             }
         }
         ImGui::End();
@@ -233,11 +745,15 @@ struct MemoryEditor
             Cols = 1;
 
         ImU8* mem_data = (ImU8*)mem_data_void;
-        Sizes s;
-        CalcSizes(s, mem_size, base_display_addr);
+        const Sizes& s = GetSizes(mem_size, base_display_addr);
         ImGuiStyle& style = ImGui::GetStyle();
 
         const ImVec2 contents_pos_start = ImGui::GetCursorScreenPos();
+        const double time_start = GetStatsTime();
+        Stats = ContentsStats();
+        ImDrawList* contents_draw_list = ImGui::GetWindowDrawList();
+        const int contents_vtx_start = contents_draw_list->VtxBuffer.Size;
+        const int contents_idx_start = contents_draw_list->IdxBuffer.Size;
 
         // We begin into our scrolling region with the 'ImGuiWindowFlags_NoMove' in order to prevent click from moving the window.
         // This is used as a facility since our main click detection code doesn't assign an ActiveId so the click would normally be caught as a window-move.
@@ -245,18 +761,38 @@ struct MemoryEditor
         float footer_height = OptFooterExtraHeight;
         if (OptShowOptions)
             footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1;
+        if (OptShowSearch)
+            footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1;
         if (OptShowDataPreview)
             footer_height += height_separator + ImGui::GetFrameHeightWithSpacing() * 1 + ImGui::GetTextLineHeightWithSpacing() * 3;
-        ImGui::BeginChild("##scrolling", ImVec2(-FLT_MIN, -footer_height), ImGuiChildFlags_None, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoNav);
+        if (OptShowStructs)
+            footer_height += height_separator + ImGui::GetTextLineHeightWithSpacing() * OptStructsPanelLines;
+        if (OptShowWatches)
+            footer_height += height_separator + ImGui::GetTextLineHeightWithSpacing() * OptWatchesPanelLines;
+        // With large address spaces we can't use the clipper: float scrolling loses precision and line count may not fit in an int.
+        // Instead we emit visible lines ourselves from a 64-bit top line, and draw our own scrollbar.
+        if (Regions.Size > 0 && (RegionLinesCols != Cols || RegionLinesMemSize != mem_size))
+            BuildRegionLines(mem_size);
+        const size_t line_total_count = GetLinesCount(mem_size);
+        VirtualScroll = (line_total_count > OptVirtualScrollMinLines || line_total_count > 0x7FFFFFFF);
+        ImGuiWindowFlags child_flags = ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoNav;
+        if (VirtualScroll)
+            child_flags |= ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
+        ImGui::BeginChild("##scrolling", ImVec2(OptShowMinimap ? -(s.MinimapWidth + style.ItemSpacing.x) : -FLT_MIN, -footer_height), ImGuiChildFlags_None, child_flags);
         ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const int child_vtx_start = draw_list->VtxBuffer.Size;
+        const int child_idx_start = draw_list->IdxBuffer.Size;
 
         ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(0, 0));
         ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
 
         // We are not really using the clipper API correctly here, because we rely on visible_start_addr/visible_end_addr for our scrolling function.
-        const int line_total_count = (int)((mem_size + Cols - 1) / Cols);
         ImGuiListClipper clipper;
-        clipper.Begin(line_total_count, s.LineHeight);
+        size_t virtual_scroll_line_end = 0;
+        if (VirtualScroll)
+            virtual_scroll_line_end = UpdateVirtualScroll(s, line_total_count);
+        else
+            clipper.Begin((int)line_total_count, s.LineHeight);
 
         bool data_next = false;
 
@@ -275,217 +811,500 @@ struct MemoryEditor
             else if (ImGui::IsKeyPressed(ImGuiKey_DownArrow) && (ptrdiff_t)DataEditingAddr < (ptrdiff_t)mem_size - Cols){ data_editing_addr_next = DataEditingAddr + Cols; }
             else if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow) && (ptrdiff_t)DataEditingAddr > (ptrdiff_t)0)              { data_editing_addr_next = DataEditingAddr - 1; }
             else if (ImGui::IsKeyPressed(ImGuiKey_RightArrow) && (ptrdiff_t)DataEditingAddr < (ptrdiff_t)mem_size - 1)  { data_editing_addr_next = DataEditingAddr + 1; }
+            else if (ImGui::IsKeyPressed(ImGuiKey_PageUp) || ImGui::IsKeyPressed(ImGuiKey_PageDown))
+            {
+                const size_t page_lines = VirtualScroll ? VirtualScrollLinesCount : (size_t)(ImGui::GetWindowHeight() / s.LineHeight);
+                const size_t page_size = (page_lines > 1 ? page_lines - 1 : 1) * Cols;
+                if (ImGui::IsKeyPressed(ImGuiKey_PageUp))
+                    data_editing_addr_next = (DataEditingAddr >= page_size) ? DataEditingAddr - page_size : DataEditingAddr % Cols;
+                else
+                    data_editing_addr_next = (mem_size - DataEditingAddr > page_size) ? DataEditingAddr + page_size : mem_size - 1;
+                if (data_editing_addr_next == DataEditingAddr)
+                    data_editing_addr_next = (size_t)-1;
+            }
+            if (OptNibbleEditing && data_editing_addr_next == (size_t)-1)
+                UpdateNibbleEditing(mem_data, mem_size);
+        }
+        // Shortcuts are ignored while an item is active (e.g. Ctrl+V/Ctrl+Z typed in search, address or byte InputText() apply to that text only)
+        const bool shortcuts_allowed = ImGui::GetIO().KeyCtrl && ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && !ImGui::IsAnyItemActive();
+        if (!ReadOnly && shortcuts_allowed)
+        {
+            if (ImGui::IsKeyPressed(ImGuiKey_Z, false))
+                Undo(mem_data);
+            else if (ImGui::IsKeyPressed(ImGuiKey_Y, false))
+                Redo(mem_data);
+            else if (ImGui::IsKeyPressed(ImGuiKey_V, false))
+                PasteFromClipboard(mem_data, mem_size);
         }
+        if (HasSelection() && shortcuts_allowed && ImGui::IsKeyPressed(ImGuiKey_C, false))
+            CopySelectionToClipboard(mem_data, (CopyFormat)CopyFormatDefault);
 
         // Draw vertical separator
         ImVec2 window_pos = ImGui::GetWindowPos();
-        if (OptShowAscii)
+        if (s.PosAsciiStart < s.PosAsciiEnd)
             draw_list->AddLine(ImVec2(window_pos.x + s.PosAsciiStart - s.GlyphWidth, window_pos.y), ImVec2(window_pos.x + s.PosAsciiStart - s.GlyphWidth, window_pos.y + 9999), ImGui::GetColorU32(ImGuiCol_Border));
+        if (s.PosCompareStart < s.PosCompareEnd)
+            draw_list->AddLine(ImVec2(window_pos.x + s.PosCompareStart - s.GlyphWidth, window_pos.y), ImVec2(window_pos.x + s.PosCompareStart - s.GlyphWidth, window_pos.y + 9999), ImGui::GetColorU32(ImGuiCol_Border));
 
         const ImU32 color_text = ImGui::GetColorU32(ImGuiCol_Text);
-        const ImU32 color_disabled = OptGreyOutZeroes ? ImGui::GetColorU32(ImGuiCol_TextDisabled) : color_text;
+        const ImU32 color_text_disabled = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        const ImU32 color_selection = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+        const ImU32 color_disabled = OptGreyOutZeroes ? color_text_disabled : color_text;
+        const float line_origin_x = window_pos.x - ImGui::GetScrollX(); // Matches SameLine() offsets
+        const bool is_window_hovered = ImGui::IsWindowHovered();
+        const char* hex_lut = GetHexLut(OptUpperCaseHex);
 
-        const char* format_address = OptUpperCaseHex ? "%0*" _PRISizeT "X: " : "%0*" _PRISizeT "x: ";
-        const char* format_data = OptUpperCaseHex ? "%0*" _PRISizeT "X" : "%0*" _PRISizeT "x";
-        const char* format_byte = OptUpperCaseHex ? "%02X" : "%02x";
-        const char* format_byte_space = OptUpperCaseHex ? "%02X " : "%02x ";
+        const char* format_address = s.FormatAddress;
+        const char* format_data = s.FormatData;
+        const char* format_byte = s.FormatByte;
+        const char* format_byte_space = s.FormatByteSpace;
 
         MouseHovered = false;
         MouseHoveredAddr = 0;
+        LineBgColors.resize(Cols * 3);
+        double time_section = GetStatsTime();
+        UpdateSearch(mem_data, mem_size);
+        if (CompareMemData)
+            UpdateCompareBlocks(mem_data, mem_size);
+        if (OptShowChanges)
+            UpdateChanges(mem_data, mem_size);
+        UpdateWatches(mem_data, mem_size);
+        Stats.TimeUpdate = (float)(GetStatsTime() - time_section);
+        if (OptShowMinimap)
+        {
+            time_section = GetStatsTime();
+            UpdateMinimap(mem_data, mem_size);
+            Stats.TimeMinimap = (float)(GetStatsTime() - time_section);
+        }
+        VisibleAddrMin = (size_t)-1;
+        VisibleAddrMax = 0;
+        VisibleFrame = ImGui::GetFrameCount();
 
-        while (clipper.Step())
-            for (int line_i = clipper.DisplayStart; line_i < clipper.DisplayEnd; line_i++) // display only visible lines
+        const double time_lines_start = GetStatsTime();
+        double time_ascii = 0.0;
+
+        bool virtual_scroll_step_done = false;
+        while (VirtualScroll ? !virtual_scroll_step_done : clipper.Step())
+        {
+            const size_t step_line_min = VirtualScroll ? VirtualScrollTopLine : (size_t)clipper.DisplayStart;
+            const size_t step_line_max = VirtualScroll ? virtual_scroll_line_end : (size_t)clipper.DisplayEnd;
+            virtual_scroll_step_done = true;
+
+            // Split into runs of lines with contiguous addresses. Without regions this is a single run.
+            for (size_t line_min = step_line_min, line_max = 0; line_min < step_line_max; line_min = line_max)
             {
-                size_t addr = (size_t)line_i * Cols;
-                ImGui::Text(format_address, s.AddrDigitsCount, base_display_addr + addr);
+                const size_t addr_min = GetAddrFromLine(line_min, &line_max);
+                if (line_max > step_line_max)
+                    line_max = step_line_max;
+                if (addr_min == (size_t)-1)
+                {
+                    DrawRegionGapLine(s, line_min, base_display_addr);
+                    continue;
+                }
+                const size_t addr_max = addr_min + (line_max - line_min) * Cols;
+                if (VisibleAddrMin > addr_min)
+                    VisibleAddrMin = addr_min;
+                if (VisibleAddrMax < addr_max)
+                    VisibleAddrMax = (addr_max < mem_size) ? addr_max : mem_size;
+
+                // Read all visible bytes at once when using handlers
+                if (ReadFn || ReadRangeFn || RequestPageFn || Regions.Size > 0)
+                    FetchVisibleBytes(mem_data, mem_size, addr_min, addr_max);
+
+                // Search results are sorted by address and have the same size, walk them linearly too
+                const size_t search_result_size = (size_t)SearchPattern.Size;
+                int search_result_n = FindSearchResultIndex(addr_min >= search_result_size ? addr_min - search_result_size + 1 : 0);
+
+                // Struct field spans are sorted by address and at most 8 bytes, walk them linearly too
+                int struct_span_n = FindStructSpanIndex(addr_min >= 7 ? addr_min - 7 : 0);
+                int watch_n = FindWatchIndex(addr_min >= 7 ? addr_min - 7 : 0);
 
-                // Draw Hexadecimal
-                for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
+                // Gather background color ranges once for all visible lines, then walk them linearly
+                int color_range_n = 0;
+                ColorRanges.resize(0);
+                if (ColorRangesFn)
                 {
-                    float byte_pos_x = s.PosHexStart + s.HexCellWidth * n;
-                    if (OptMidColsCount > 0)
-                        byte_pos_x += (float)(n / OptMidColsCount) * s.SpacingBetweenMidCols;
-                    ImGui::SameLine(byte_pos_x);
-
-                    // Draw highlight or custom background color
-                    const bool is_highlight_from_user_range = (addr >= HighlightMin && addr < HighlightMax);
-                    const bool is_highlight_from_user_func = (HighlightFn && HighlightFn(mem_data, addr, UserData));
-                    const bool is_highlight_from_preview = (addr >= DataPreviewAddr && addr < DataPreviewAddr + preview_data_type_size);
-
-                    ImU32 bg_color = 0;
-                    bool is_next_byte_highlighted = false;
-                    if (is_highlight_from_user_range || is_highlight_from_user_func || is_highlight_from_preview)
+                    Stats.ColorRangesFnCalls++;
+                    ColorRangesFn(mem_data, addr_min, addr_max, &ColorRanges, UserData);
+                    for (int n = 1; n < ColorRanges.Size; n++)
+                        IM_ASSERT(ColorRanges[n - 1].Max <= ColorRanges[n].Min && "ColorRangesFn() output must be sorted and non-overlapping!");
+                }
+
+                for (size_t line_i = line_min; line_i < line_max; line_i++) // display only visible lines
+                {
+                    const size_t line_addr = addr_min + (line_i - line_min) * Cols;
+                    size_t addr = line_addr;
+                    const float line_pos_y = ImGui::GetCursorScreenPos().y;
+                    const int line_cols = (mem_size - addr < (size_t)Cols) ? (int)(mem_size - addr) : Cols;
+                    if (OptDisplayMode == DisplayMode_Pixels)
+                        ImGui::Dummy(ImVec2(s.PosHexEnd, s.LineHeight));
+                    else
+                        ImGui::Text(format_address, s.AddrDigitsCount, base_display_addr + addr);
+                    Stats.LinesDrawn++;
+                    Stats.BytesDrawn += line_cols;
+                    if (HighlightFn)
+                        Stats.HighlightFnCalls += line_cols;
+
+                    // Evaluate highlight and custom background colors once per byte
+                    ImU32* hex_bg_colors = LineBgColors.Data;
+                    ImU32* ascii_bg_colors = LineBgColors.Data + Cols;
+                    ImU32* compare_bg_colors = LineBgColors.Data + Cols * 2;
+                    for (int n = 0; n < line_cols; n++)
                     {
-                        is_next_byte_highlighted = (addr + 1 < mem_size) && ((HighlightMax != (size_t)-1 && addr + 1 < HighlightMax) || (HighlightFn && HighlightFn(mem_data, addr + 1, UserData)) || (addr + 1 < DataPreviewAddr + preview_data_type_size));
-                        bg_color = HighlightColor;
+                        const size_t cell_addr = addr + n;
+                        const bool is_highlight_from_user_range = (cell_addr >= HighlightMin && cell_addr < HighlightMax);
+                        const bool is_highlight_from_user_func = (HighlightFn && HighlightFn(mem_data, cell_addr, UserData));
+                        const bool is_highlight_from_preview = (cell_addr >= DataPreviewAddr && cell_addr < DataPreviewAddr + preview_data_type_size);
+                        while (color_range_n < ColorRanges.Size && ColorRanges[color_range_n].Max <= cell_addr)
+                            color_range_n++;
+                        ImU32 bg_color = 0;
+                        if (color_range_n < ColorRanges.Size && ColorRanges[color_range_n].Min <= cell_addr)
+                            bg_color = ColorRanges[color_range_n].Color;
+                        else if (BgColorFn)
+                        {
+                            Stats.BgColorFnCalls++;
+                            bg_color = BgColorFn(mem_data, cell_addr, UserData);
+                        }
+                        if (bg_color == 0 && StructSpans.Size > 0)
+                            bg_color = GetStructFieldColor(&struct_span_n, cell_addr);
+                        if (Watches.Size > 0)
+                            if (const ImU32 watch_color = GetWatchColor(&watch_n, cell_addr))
+                                bg_color = watch_color;
+                        while (search_result_n < SearchResults.Size && SearchResults[search_result_n] + search_result_size <= cell_addr)
+                            search_result_n++;
+                        if (search_result_n < SearchResults.Size && SearchResults[search_result_n] <= cell_addr)
+                            bg_color = SearchResultColor;
+                        if (OptShowChanges && cell_addr - ChangesAddr < (size_t)ChangesHeat.Size)
+                            if (const int heat = ChangesHeat.Data[cell_addr - ChangesAddr])
+                                bg_color = (ChangedColor & ~IM_COL32_A_MASK) | ((((ChangedColor >> IM_COL32_A_SHIFT) & 0xFF) * heat / 255) << IM_COL32_A_SHIFT);
+                        if (CompareMemData)
+                        {
+                            const bool is_different = (cell_addr >= CompareMemSize || (GetByteStatus(cell_addr) == ByteStatus_Ok && ReadByte(mem_data, cell_addr) != CompareMemData[cell_addr]));
+                            if (is_different)
+                                bg_color = CompareDiffColor;
+                            compare_bg_colors[n] = is_different ? CompareDiffColor : 0;
+                        }
+                        if (cell_addr >= SelectMin && cell_addr < SelectMax)
+                            bg_color = color_selection;
+                        hex_bg_colors[n] = (is_highlight_from_user_range || is_highlight_from_user_func || is_highlight_from_preview) ? HighlightColor : bg_color;
+                        ascii_bg_colors[n] = (cell_addr == DataEditingAddr) ? 0 : bg_color;
                     }
-                    else if (BgColorFn != nullptr)
+                    if (OptDisplayMode == DisplayMode_Pixels)
                     {
-                        is_next_byte_highlighted = (addr + 1 < mem_size) && ((BgColorFn(mem_data, addr + 1, UserData) & IM_COL32_A_MASK) != 0);
-                        bg_color = BgColorFn(mem_data, addr, UserData);
+                        DrawPixelsLine(s, mem_data, mem_size, base_display_addr, line_addr, line_cols, ImVec2(line_origin_x, line_pos_y), hex_bg_colors, is_window_hovered);
+                        continue;
                     }
-                    if (bg_color != 0)
+
+                    // Draw highlight or custom background color, merging adjacent cells of same color
+                    for (int column_n = 0; column_n < ((s.PosCompareStart < s.PosCompareEnd) ? 2 : 1); column_n++)
                     {
-                        float bg_width = s.GlyphWidth * 2;
-                        if (is_next_byte_highlighted || (n + 1 == Cols))
+                        const ImU32* bg_colors = (column_n == 0) ? hex_bg_colors : compare_bg_colors;
+                        const float column_origin_x = line_origin_x + ((column_n == 0) ? 0.0f : s.PosCompareStart - s.PosHexStart);
+                        for (int n = 0, n_end = 0; n < line_cols; n = n_end)
                         {
-                            bg_width = s.HexCellWidth;
-                            if (OptMidColsCount > 0 && n > 0 && (n + 1) < Cols && ((n + 1) % OptMidColsCount) == 0)
-                                bg_width += s.SpacingBetweenMidCols;
+                            const ImU32 bg_color = bg_colors[n];
+                            for (n_end = n + 1; n_end < line_cols && bg_colors[n_end] == bg_color; n_end++) {}
+                            if (bg_color == 0)
+                                continue;
+                            // Extend to next cell when it is also colored, so there's no gap between runs
+                            float bg_x2 = GetHexCellPosX(s, n_end - 1) + ((OptDisplayMode == DisplayMode_Words) ? s.HexCellWidth - s.GlyphWidth : s.GlyphWidth * 2);
+                            if (n_end == Cols)
+                                bg_x2 = GetHexCellPosX(s, n_end - 1) + s.HexCellWidth;
+                            else if (n_end < line_cols && (bg_colors[n_end] & IM_COL32_A_MASK) != 0)
+                                bg_x2 = GetHexCellPosX(s, n_end);
+                            draw_list->AddRectFilled(ImVec2(column_origin_x + GetHexCellPosX(s, n), line_pos_y), ImVec2(column_origin_x + bg_x2, line_pos_y + s.LineHeight), bg_color);
                         }
-                        ImVec2 pos = ImGui::GetCursorScreenPos();
-                        draw_list->AddRectFilled(pos, ImVec2(pos.x + bg_width, pos.y + s.LineHeight), bg_color);
                     }
 
-                    if (DataEditingAddr == addr)
+                    // Draw Hexadecimal (or words)
+                    if (OptDisplayMode == DisplayMode_Words)
+                        DrawWordsLine(s, mem_data, line_addr, line_cols, ImVec2(line_origin_x, line_pos_y), is_window_hovered);
+                    const int hex_cols = (OptDisplayMode == DisplayMode_Hex) ? Cols : 0;
+                    for (int n = 0; n < hex_cols && addr < mem_size; n++, addr++)
                     {
-                        // Display text input on current byte
-                        bool data_write = false;
-                        ImGui::PushID((void*)addr);
-                        if (DataEditingTakeFocus)
+                        const float byte_pos_x = GetHexCellPosX(s, n);
+                        const ImVec2 byte_pos(line_origin_x + byte_pos_x, line_pos_y);
+                        const bool is_nibble_editing = (OptNibbleEditing && DataEditingAddr == addr);
+                        if ((!OptFastRendering || DataEditingAddr == addr) && !is_nibble_editing)
+                            ImGui::SameLine(byte_pos_x);
+
+                        if (is_nibble_editing)
                         {
-                            ImGui::SetKeyboardFocusHere(0);
-                            ImSnprintf(AddrInputBuf, 32, format_data, s.AddrDigitsCount, base_display_addr + addr);
-                            ImSnprintf(DataInputBuf, 32, format_byte, ReadFn ? ReadFn(mem_data, addr, UserData) : mem_data[addr]);
+                            // Edited byte with a cursor on the edited nibble. Typed digits were applied by UpdateNibbleEditing().
+                            const ImU8 b = ReadByte(mem_data, addr);
+                            const char glyphs[2] = { hex_lut[b * 2], hex_lut[b * 2 + 1] };
+                            const float nibble_x = byte_pos.x + ((DataEditingLowNibbleAddr == addr) ? s.GlyphWidth : 0.0f);
+                            draw_list->AddRectFilled(byte_pos, ImVec2(byte_pos.x + s.GlyphWidth * 2, byte_pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
+                            draw_list->AddRectFilled(ImVec2(nibble_x, byte_pos.y), ImVec2(nibble_x + s.GlyphWidth, byte_pos.y + s.LineHeight), color_selection);
+                            draw_list->AddText(byte_pos, (GetByteStatus(addr) == ByteStatus_Ok) ? color_text : color_text_disabled, glyphs, glyphs + 2);
+                            if (is_window_hovered && ImGui::IsMouseHoveringRect(byte_pos, ImVec2(byte_pos.x + s.HexCellWidth, byte_pos.y + s.LineHeight)))
+                            {
+                                MouseHovered = true;
+                                MouseHoveredAddr = addr;
+                                if (ImGui::IsMouseClicked(0))
+                                    DataEditingLowNibbleAddr = (ImGui::GetIO().MousePos.x >= byte_pos.x + s.GlyphWidth) ? addr : (size_t)-1;
+                            }
                         }
-                        struct InputTextUserData
+                        else if (DataEditingAddr == addr)
                         {
-                            // FIXME: We should have a way to retrieve the text edit cursor position more easily in the API, this is rather tedious. This is such a ugly mess we may be better off not using InputText() at all here.
-                            static int Callback(ImGuiInputTextCallbackData* data)
+                            // Display text input on current byte
+                            bool data_write = false;
+                            ImGui::PushID((void*)addr);
+                            if (DataEditingTakeFocus)
                             {
-                                InputTextUserData* user_data = (InputTextUserData*)data->UserData;
-                                if (!data->HasSelection())
-                                    user_data->CursorPos = data->CursorPos;
-#if IMGUI_VERSION_NUM < 19102
-                                if (data->Flags & ImGuiInputTextFlags_ReadOnly)
-                                    return 0;
-#endif
-                                if (data->SelectionStart == 0 && data->SelectionEnd == data->BufTextLen)
+                                ImGui::SetKeyboardFocusHere(0);
+                                ImSnprintf(AddrInputBuf, 32, format_data, s.AddrDigitsCount, base_display_addr + addr);
+                                ImSnprintf(DataInputBuf, 32, format_byte, ReadByte(mem_data, addr));
+                            }
+                            struct InputTextUserData
+                            {
+                                // FIXME: We should have a way to retrieve the text edit cursor position more easily in the API, this is rather tedious. This is such a ugly mess we may be better off not using InputText() at all here.
+                                static int Callback(ImGuiInputTextCallbackData* data)
                                 {
-                                    // When not editing a byte, always refresh its InputText content pulled from underlying memory data
-                                    // (this is a bit tricky, since InputText technically "owns" the master copy of the buffer we edit it in there)
-                                    data->DeleteChars(0, data->BufTextLen);
-                                    data->InsertChars(0, user_data->CurrentBufOverwrite);
-                                    data->SelectionStart = 0;
-                                    data->SelectionEnd = 2;
-                                    data->CursorPos = 0;
+                                    InputTextUserData* user_data = (InputTextUserData*)data->UserData;
+                                    if (!data->HasSelection())
+                                        user_data->CursorPos = data->CursorPos;
+    #if IMGUI_VERSION_NUM < 19102
+                                    if (data->Flags & ImGuiInputTextFlags_ReadOnly)
+                                        return 0;
+    #endif
+                                    if (data->SelectionStart == 0 && data->SelectionEnd == data->BufTextLen)
+                                    {
+                                        // When not editing a byte, always refresh its InputText content pulled from underlying memory data
+                                        // (this is a bit tricky, since InputText technically "owns" the master copy of the buffer we edit it in there)
+                                        data->DeleteChars(0, data->BufTextLen);
+                                        data->InsertChars(0, user_data->CurrentBufOverwrite);
+                                        data->SelectionStart = 0;
+                                        data->SelectionEnd = 2;
+                                        data->CursorPos = 0;
+                                    }
+                                    return 0;
                                 }
-                                return 0;
+                                char   CurrentBufOverwrite[3];  // Input
+                                int    CursorPos;               // Output
+                            };
+                            InputTextUserData input_text_user_data;
+                            input_text_user_data.CursorPos = -1;
+                            ImSnprintf(input_text_user_data.CurrentBufOverwrite, 3, format_byte, ReadByte(mem_data, addr));
+                            ImGuiInputTextFlags flags = ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll | ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_CallbackAlways;
+                            if (ReadOnly)
+                                flags |= ImGuiInputTextFlags_ReadOnly;
+                            flags |= ImGuiInputTextFlags_AlwaysOverwrite; // was ImGuiInputTextFlags_AlwaysInsertMode
+                            ImGui::SetNextItemWidth(s.GlyphWidth * 2);
+                            if (ImGui::InputText("##data", DataInputBuf, IM_ARRAYSIZE(DataInputBuf), flags, InputTextUserData::Callback, &input_text_user_data))
+                                data_write = data_next = true;
+                            else if (!DataEditingTakeFocus && !ImGui::IsItemActive())
+                                DataEditingAddr = data_editing_addr_next = (size_t)-1;
+                            DataEditingTakeFocus = false;
+                            if (input_text_user_data.CursorPos >= 2)
+                                data_write = data_next = true;
+                            if (data_editing_addr_next != (size_t)-1)
+                                data_write = data_next = false;
+                            unsigned int data_input_value = 0;
+                            if (!ReadOnly && data_write && sscanf(DataInputBuf, "%X", &data_input_value) == 1)
+                            {
+                                const ImU8 data_value = (ImU8)data_input_value;
+                                WriteBytes(mem_data, addr, &data_value, 1);
+                            }
+                            if (ImGui::IsItemHovered())
+                            {
+                                MouseHovered = true;
+                                MouseHoveredAddr = addr;
                             }
-                            char   CurrentBufOverwrite[3];  // Input
-                            int    CursorPos;               // Output
-                        };
-                        InputTextUserData input_text_user_data;
-                        input_text_user_data.CursorPos = -1;
-                        ImSnprintf(input_text_user_data.CurrentBufOverwrite, 3, format_byte, ReadFn ? ReadFn(mem_data, addr, UserData) : mem_data[addr]);
-                        ImGuiInputTextFlags flags = ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_AutoSelectAll | ImGuiInputTextFlags_NoHorizontalScroll | ImGuiInputTextFlags_CallbackAlways;
-                        if (ReadOnly)
-                            flags |= ImGuiInputTextFlags_ReadOnly;
-                        flags |= ImGuiInputTextFlags_AlwaysOverwrite; // was ImGuiInputTextFlags_AlwaysInsertMode
-                        ImGui::SetNextItemWidth(s.GlyphWidth * 2);
-                        if (ImGui::InputText("##data", DataInputBuf, IM_ARRAYSIZE(DataInputBuf), flags, InputTextUserData::Callback, &input_text_user_data))
-                            data_write = data_next = true;
-                        else if (!DataEditingTakeFocus && !ImGui::IsItemActive())
-                            DataEditingAddr = data_editing_addr_next = (size_t)-1;
-                        DataEditingTakeFocus = false;
-                        if (input_text_user_data.CursorPos >= 2)
-                            data_write = data_next = true;
-                        if (data_editing_addr_next != (size_t)-1)
-                            data_write = data_next = false;
-                        unsigned int data_input_value = 0;
-                        if (!ReadOnly && data_write && sscanf(DataInputBuf, "%X", &data_input_value) == 1)
+                            ImGui::PopID();
+                        }
+                        else if (OptFastRendering)
                         {
-                            if (WriteFn)
-                                WriteFn(mem_data, addr, (ImU8)data_input_value, UserData);
-                            else
-                                mem_data[addr] = (ImU8)data_input_value;
+                            // Fast path: write glyphs directly, hit testing is done once per line below.
+                            const ImU8 b = ReadByte(mem_data, addr);
+                            const int b_status = GetByteStatus(addr);
+                            char glyphs[2] = { hex_lut[b * 2], hex_lut[b * 2 + 1] };
+                            ImU32 glyphs_color = color_text;
+                            if (b_status != ByteStatus_Ok)
+                            {
+                                glyphs[0] = glyphs[1] = (b_status == ByteStatus_Pending) ? '.' : '?';
+                                glyphs_color = color_text_disabled;
+                            }
+                            else if (OptShowHexII)
+                            {
+                                if ((b >= 32 && b < 128))
+                                    glyphs[0] = '.', glyphs[1] = (char)b;
+                                else if (b == 0xFF && OptGreyOutZeroes)
+                                    glyphs[0] = glyphs[1] = '#', glyphs_color = color_text_disabled;
+                                else if (b == 0x00)
+                                    glyphs_color = 0;
+                            }
+                            else if (b == 0 && OptGreyOutZeroes)
+                            {
+                                glyphs_color = color_text_disabled;
+                            }
+                            if (glyphs_color != 0)
+                                draw_list->AddText(byte_pos, glyphs_color, glyphs, glyphs + 2);
                         }
-                        if (ImGui::IsItemHovered())
+                        else
                         {
-                            MouseHovered = true;
-                            MouseHoveredAddr = addr;
+                            // NB: The trailing space is not visible but ensure there's no gap that the mouse cannot click on.
+                            ImU8 b = ReadByte(mem_data, addr);
+                            const int b_status = GetByteStatus(addr);
+
+                            if (b_status != ByteStatus_Ok)
+                            {
+                                ImGui::TextDisabled(b_status == ByteStatus_Pending ? ".. " : "?? ");
+                            }
+                            else if (OptShowHexII)
+                            {
+                                if ((b >= 32 && b < 128))
+                                    ImGui::Text(".%c ", b);
+                                else if (b == 0xFF && OptGreyOutZeroes)
+                                    ImGui::TextDisabled("## ");
+                                else if (b == 0x00)
+                                    ImGui::Text("   ");
+                                else
+                                    ImGui::Text(format_byte_space, b);
+                            }
+                            else
+                            {
+                                if (b == 0 && OptGreyOutZeroes)
+                                    ImGui::TextDisabled("00 ");
+                                else
+                                    ImGui::Text(format_byte_space, b);
+                            }
+                            if (ImGui::IsItemHovered())
+                            {
+                                MouseHovered = true;
+                                MouseHoveredAddr = addr;
+                                if (ImGui::IsMouseClicked(0))
+                                {
+                                    DataEditingTakeFocus = true;
+                                    data_editing_addr_next = addr;
+                                }
+                            }
                         }
-                        ImGui::PopID();
                     }
-                    else
-                    {
-                        // NB: The trailing space is not visible but ensure there's no gap that the mouse cannot click on.
-                        ImU8 b = ReadFn ? ReadFn(mem_data, addr, UserData) : mem_data[addr];
 
-                        if (OptShowHexII)
+                    if (OptFastRendering && OptDisplayMode == DisplayMode_Hex && is_window_hovered)
+                    {
+                        // Hit test hexadecimal values of the whole line at once
+                        const ImVec2 mouse_pos = ImGui::GetIO().MousePos;
+                        const float mouse_off_x = mouse_pos.x - (line_origin_x + s.PosHexStart);
+                        if (mouse_pos.y >= line_pos_y && mouse_pos.y < line_pos_y + s.LineHeight && mouse_off_x >= 0.0f && mouse_off_x < GetHexCellPosX(s, Cols - 1) + s.HexCellWidth - s.PosHexStart)
                         {
-                            if ((b >= 32 && b < 128))
-                                ImGui::Text(".%c ", b);
-                            else if (b == 0xFF && OptGreyOutZeroes)
-                                ImGui::TextDisabled("## ");
-                            else if (b == 0x00)
-                                ImGui::Text("   ");
-                            else
-                                ImGui::Text(format_byte_space, b);
+                            const size_t mouse_addr = line_addr + GetHexCellFromOffsetX(s, mouse_off_x);
+                            if (mouse_addr < mem_size && mouse_addr != DataEditingAddr)
+                            {
+                                MouseHovered = true;
+                                MouseHoveredAddr = mouse_addr;
+                                if (ImGui::IsMouseClicked(0))
+                                {
+                                    DataEditingTakeFocus = true;
+                                    data_editing_addr_next = mouse_addr;
+                                }
+                            }
                         }
-                        else
+                    }
+
+                    const double time_ascii_start = (OptShowAscii && GetTimeFn) ? GetStatsTime() : 0.0;
+                    if (OptShowAscii)
+                    {
+                        // Draw ASCII values
+                        ImGui::SameLine(s.PosAsciiStart);
+                        ImVec2 pos = ImGui::GetCursorScreenPos();
+                        addr = line_addr;
+
+                        const float mouse_off_x = ImGui::GetIO().MousePos.x - pos.x;
+                        const size_t mouse_addr = (mouse_off_x >= 0.0f && mouse_off_x < s.PosAsciiEnd - s.PosAsciiStart) ? addr + (size_t)(mouse_off_x / s.GlyphWidth) : (size_t)-1;
+
+                        ImGui::PushID((void*)line_i);
+                        if (ImGui::InvisibleButton("ascii", ImVec2(s.PosAsciiEnd - s.PosAsciiStart, s.LineHeight)))
                         {
-                            if (b == 0 && OptGreyOutZeroes)
-                                ImGui::TextDisabled("00 ");
-                            else
-                                ImGui::Text(format_byte_space, b);
+                            DataEditingAddr = DataPreviewAddr = mouse_addr;
+                            DataEditingTakeFocus = true;
                         }
                         if (ImGui::IsItemHovered())
                         {
                             MouseHovered = true;
-                            MouseHoveredAddr = addr;
-                            if (ImGui::IsMouseClicked(0))
+                            MouseHoveredAddr = mouse_addr;
+                        }
+                        ImGui::PopID();
+                        for (int n = 0, n_end = 0; n < line_cols; n = n_end)
+                        {
+                            const ImU32 bg_color = ascii_bg_colors[n];
+                            for (n_end = n + 1; n_end < line_cols && ascii_bg_colors[n_end] == bg_color; n_end++) {}
+                            if (bg_color != 0)
+                                draw_list->AddRectFilled(ImVec2(pos.x + n * s.GlyphWidth, pos.y), ImVec2(pos.x + n_end * s.GlyphWidth, pos.y + s.LineHeight), bg_color);
+                        }
+                        for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
+                        {
+                            if (addr == DataEditingAddr)
                             {
-                                DataEditingTakeFocus = true;
-                                data_editing_addr_next = addr;
+                                draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
+                                draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_TextSelectedBg));
                             }
+                            unsigned char c = ReadByte(mem_data, addr);
+                            char display_c = (c < 32 || c >= 128) ? '.' : c;
+                            if (const int c_status = GetByteStatus(addr))
+                                display_c = (c_status == ByteStatus_Pending) ? ' ' : '?';
+                            draw_list->AddText(pos, (display_c == c) ? color_text : color_disabled, &display_c, &display_c + 1);
+                            pos.x += s.GlyphWidth;
                         }
+                        if (GetTimeFn)
+                            time_ascii += GetStatsTime() - time_ascii_start;
                     }
-                }
-
-                if (OptShowAscii)
-                {
-                    // Draw ASCII values
-                    ImGui::SameLine(s.PosAsciiStart);
-                    ImVec2 pos = ImGui::GetCursorScreenPos();
-                    addr = (size_t)line_i * Cols;
-
-                    const float mouse_off_x = ImGui::GetIO().MousePos.x - pos.x;
-                    const size_t mouse_addr = (mouse_off_x >= 0.0f && mouse_off_x < s.PosAsciiEnd - s.PosAsciiStart) ? addr + (size_t)(mouse_off_x / s.GlyphWidth) : (size_t)-1;
 
-                    ImGui::PushID(line_i);
-                    if (ImGui::InvisibleButton("ascii", ImVec2(s.PosAsciiEnd - s.PosAsciiStart, s.LineHeight)))
-                    {
-                        DataEditingAddr = DataPreviewAddr = mouse_addr;
-                        DataEditingTakeFocus = true;
-                    }
-                    if (ImGui::IsItemHovered())
-                    {
-                        MouseHovered = true;
-                        MouseHoveredAddr = mouse_addr;
-                    }
-                    ImGui::PopID();
-                    for (int n = 0; n < Cols && addr < mem_size; n++, addr++)
+                    if (s.PosCompareStart < s.PosCompareEnd)
                     {
-                        if (addr == DataEditingAddr)
+                        // Draw compare data, read-only
+                        const float column_origin_x = line_origin_x + s.PosCompareStart - s.PosHexStart;
+                        addr = line_addr;
+                        for (int n = 0; n < line_cols && addr < CompareMemSize; n++, addr++)
                         {
-                            draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
-                            draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), ImGui::GetColorU32(ImGuiCol_TextSelectedBg));
+                            const ImU8 b = CompareMemData[addr];
+                            const char glyphs[2] = { hex_lut[b * 2], hex_lut[b * 2 + 1] };
+                            draw_list->AddText(ImVec2(column_origin_x + GetHexCellPosX(s, n), line_pos_y), (b == 0) ? color_disabled : color_text, glyphs, glyphs + 2);
                         }
-                        else if (BgColorFn)
+                        if (is_window_hovered)
                         {
-                            draw_list->AddRectFilled(pos, ImVec2(pos.x + s.GlyphWidth, pos.y + s.LineHeight), BgColorFn(mem_data, addr, UserData));
+                            const ImVec2 mouse_pos = ImGui::GetIO().MousePos;
+                            const float mouse_off_x = mouse_pos.x - (line_origin_x + s.PosCompareStart);
+                            if (mouse_pos.y >= line_pos_y && mouse_pos.y < line_pos_y + s.LineHeight && mouse_off_x >= 0.0f && mouse_off_x < s.PosCompareEnd - s.PosCompareStart)
+                            {
+                                const size_t mouse_addr = line_addr + GetHexCellFromOffsetX(s, mouse_off_x);
+                                if (mouse_addr < mem_size)
+                                {
+                                    MouseHovered = true;
+                                    MouseHoveredAddr = mouse_addr;
+                                }
+                            }
                         }
-                        unsigned char c = ReadFn ? ReadFn(mem_data, addr, UserData) : mem_data[addr];
-                        char display_c = (c < 32 || c >= 128) ? '.' : c;
-                        draw_list->AddText(pos, (display_c == c) ? color_text : color_disabled, &display_c, &display_c + 1);
-                        pos.x += s.GlyphWidth;
                     }
                 }
             }
+        }
+        Stats.TimeAscii = (float)time_ascii;
+        Stats.TimeGrid = (float)(GetStatsTime() - time_lines_start - time_ascii);
+        UpdateSelection();
+        if (OptNibbleEditing && DataEditingAddr != (size_t)-1 && !DataEditingTakeFocus && data_editing_addr_next == (size_t)-1)
+            if ((ImGui::IsMouseClicked(0) && !MouseHovered) || !ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows))
+                DataEditingAddr = (size_t)-1;
+        if (VisibleAddrMin > VisibleAddrMax)
+            VisibleAddrMin = VisibleAddrMax;
+        if (MouseHovered && StructSpans.Size > 0)
+            DrawStructFieldTooltip(s, mem_data, mem_size, base_display_addr, MouseHoveredAddr);
+        if (VirtualScroll)
+            DrawVirtualScrollbar(line_total_count);
         ImGui::PopStyleVar(2);
         const float child_width = ImGui::GetWindowSize().x;
+        const float child_height = ImGui::GetWindowSize().y;
+        Stats.VtxCount += draw_list->VtxBuffer.Size - child_vtx_start;
+        Stats.IdxCount += draw_list->IdxBuffer.Size - child_idx_start;
         ImGui::EndChild();
+        if (OptShowMinimap)
+        {
+            time_section = GetStatsTime();
+            ImGui::SameLine();
+            DrawMinimap(s, mem_size, base_display_addr, child_height);
+            Stats.TimeMinimap += (float)(GetStatsTime() - time_section);
+        }
 
         // Notify the main window of our ideal child content size (FIXME: we are missing an API to get the contents size from the child)
         ImGui::SetCursorPosX(s.WindowWidth);
@@ -500,8 +1319,36 @@ struct MemoryEditor
         {
             DataEditingAddr = DataPreviewAddr = data_editing_addr_next;
             DataEditingTakeFocus = true;
+            UndoMergeAllowed = false;
+        }
+        if (VirtualScroll && DataEditingTakeFocus && DataEditingAddr != (size_t)-1)
+        {
+            // Follow edited address, as SetKeyboardFocusHere() cannot scroll to lines which are not emitted
+            const size_t line = GetLineFromAddr(DataEditingAddr);
+            if (line < VirtualScrollTopLine)
+                VirtualScrollTopLine = line;
+            else if (line >= VirtualScrollTopLine + VirtualScrollLinesCount)
+                VirtualScrollTopLine = line - VirtualScrollLinesCount + 1;
+        }
+        else if (OptNibbleEditing && DataEditingTakeFocus && DataEditingAddr != (size_t)-1)
+        {
+            // Follow edited address, as there is no focused InputText() to scroll to
+            ImGui::BeginChild("##scrolling");
+            const float line_y = ImGui::GetCursorStartPos().y + GetLineFromAddr(DataEditingAddr) * s.LineHeight;
+            if (line_y < ImGui::GetScrollY())
+                ImGui::SetScrollY(line_y);
+            else if (line_y + s.LineHeight > ImGui::GetScrollY() + ImGui::GetWindowHeight())
+                ImGui::SetScrollY(line_y + s.LineHeight - ImGui::GetWindowHeight());
+            ImGui::EndChild();
+        }
+        if (OptNibbleEditing && DataEditingTakeFocus)
+        {
+            if (DataEditingAddr != (size_t)-1)
+                ImSnprintf(AddrInputBuf, 32, s.FormatData, s.AddrDigitsCount, base_display_addr + DataEditingAddr);
+            DataEditingTakeFocus = false;
         }
 
+        time_section = GetStatsTime();
         const bool lock_show_data_preview = OptShowDataPreview;
         if (OptShowOptions)
         {
@@ -509,12 +1356,34 @@ struct MemoryEditor
             DrawOptionsLine(s, mem_data, mem_size, base_display_addr);
         }
 
+        if (OptShowSearch)
+        {
+            ImGui::Separator();
+            DrawSearchLine(s, mem_data, mem_size, base_display_addr);
+        }
+
         if (lock_show_data_preview)
         {
+            if (RequestPageFn && DataPreviewAddr != (size_t)-1)
+                RequestPages(mem_data, mem_size, DataPreviewAddr, DataPreviewAddr + DataTypeGetSize(PreviewDataType));
             ImGui::Separator();
             DrawPreviewLine(s, mem_data, mem_size, base_display_addr);
         }
 
+        if (OptShowStructs)
+        {
+            ImGui::Separator();
+            DrawStructsPanel(s, mem_data, mem_size, base_display_addr);
+        }
+
+        if (OptShowWatches)
+        {
+            ImGui::Separator();
+            DrawWatchesPanel(s, base_display_addr);
+        }
+        ReadBuf.resize(0);
+        Stats.TimeFooter = (float)(GetStatsTime() - time_section);
+
         const ImVec2 contents_pos_end(contents_pos_start.x + child_width, ImGui::GetCursorScreenPos().y);
         //ImGui::GetForegroundDrawList()->AddRect(contents_pos_start, contents_pos_end, IM_COL32(255, 0, 0, 255));
         if (OptShowOptions)
@@ -525,20 +1394,130 @@ struct MemoryEditor
         if (ImGui::BeginPopup("OptionsPopup"))
         {
             ImGui::SetNextItemWidth(s.GlyphWidth * 7 + style.FramePadding.x * 2.0f);
-            if (ImGui::DragInt("##cols", &Cols, 0.2f, 4, 32, "%d cols")) { ContentsWidthChanged = true; if (Cols < 1) Cols = 1; }
+            if (ImGui::DragInt("##cols", &Cols, 0.2f, 4, (OptDisplayMode == DisplayMode_Pixels) ? 4096 : 32, "%d cols")) { ContentsWidthChanged = true; if (Cols < 1) Cols = 1; }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(s.GlyphWidth * 12.0f + style.FramePadding.x * 2.0f + ImGui::GetFrameHeight());
+            if (ImGui::Combo("##display_mode", &OptDisplayMode, "Hexadecimal\0Words\0Pixels\0\0")) { ContentsWidthChanged = true; }
+            if (OptDisplayMode == DisplayMode_Words)
+            {
+                ImGui::SetNextItemWidth(s.GlyphWidth * 10.0f + style.FramePadding.x * 2.0f + ImGui::GetFrameHeight());
+                if (ImGui::Combo("##words_type", &PreviewDataType, "Int8\0Uint8\0Int16\0Uint16\0Int32\0Uint32\0Int64\0Uint64\0Float\0Double\0\0")) { ContentsWidthChanged = true; }
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(s.GlyphWidth * 6.0f + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
+                ImGui::Combo("##words_endianness", &PreviewEndianness, "LE\0BE\0\0");
+            }
+            else if (OptDisplayMode == DisplayMode_Pixels)
+            {
+                ImGui::SetNextItemWidth(s.GlyphWidth * 12.0f + style.FramePadding.x * 2.0f + ImGui::GetFrameHeight());
+                ImGui::Combo("##pixel_format", &OptPixelFormat, "Gray8\0Byte classes\0RGBA32\0\0");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(s.GlyphWidth * 7 + style.FramePadding.x * 2.0f);
+                if (ImGui::DragInt("##pixel_size", &OptPixelSize, 0.1f, 1, 16, "%d px")) { ContentsWidthChanged = true; if (OptPixelSize < 1) OptPixelSize = 1; }
+            }
             ImGui::Checkbox("Show Data Preview", &OptShowDataPreview);
             ImGui::Checkbox("Show HexII", &OptShowHexII);
+            ImGui::Checkbox("Nibble Editing", &OptNibbleEditing);
+            ImGui::Checkbox("Show Stats Overlay", &OptShowStatsOverlay);
             if (ImGui::Checkbox("Show Ascii", &OptShowAscii)) { ContentsWidthChanged = true; }
             ImGui::Checkbox("Grey out zeroes", &OptGreyOutZeroes);
             ImGui::Checkbox("Uppercase Hex", &OptUpperCaseHex);
+            ImGui::Checkbox("Show Search", &OptShowSearch);
+            ImGui::Checkbox("Show Structs", &OptShowStructs);
+            ImGui::Checkbox("Show Watches", &OptShowWatches);
+            if (ImGui::Checkbox("Show Minimap", &OptShowMinimap)) { ContentsWidthChanged = true; }
+            if (OptShowMinimap)
+            {
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(s.GlyphWidth * 12.0f + style.FramePadding.x * 2.0f + ImGui::GetFrameHeight());
+                ImGui::Combo("##minimap_mode", &OptMinimapMode, "Entropy\0Byte classes\0\0");
+            }
+            ImGui::Checkbox("Show Changes", &OptShowChanges);
+            if (OptShowChanges)
+            {
+                ImGui::SameLine();
+                bool pinned = ChangesPinned;
+                if (ImGui::Checkbox("Pin Snapshot", &pinned))
+                    pinned ? PinChangesSnapshot() : UnpinChangesSnapshot();
+            }
+            const char* copy_labels[CopyFormat_COUNT] = { "Copy Hex", "Copy C Array", "Copy Base64" };
+            bool copy_too_large = false;
+            for (int format_n = 0; format_n < CopyFormat_COUNT; format_n++)
+            {
+                const bool can_copy = HasSelection() && SelectMax - SelectMin <= GetCopyMaxSize((CopyFormat)format_n);
+                copy_too_large |= (HasSelection() && !can_copy);
+                if (format_n > 0)
+                    ImGui::SameLine();
+                ImGui::BeginDisabled(!can_copy);
+                if (ImGui::Button(copy_labels[format_n]))
+                    CopySelectionToClipboard(mem_data, (CopyFormat)format_n);
+                ImGui::EndDisabled();
+            }
+            if (copy_too_large)
+                ImGui::TextDisabled("Selection too large to copy in some formats (max %d MB as C array).", (int)(GetCopyMaxSize(CopyFormat_CArray) >> 20));
+            if (!ReadOnly)
+            {
+                ImGui::SameLine();
+                if (ImGui::Button("Paste"))
+                    PasteFromClipboard(mem_data, mem_size);
+                ImGui::SameLine();
+                if (ImGui::Button("Paste Base64"))
+                    PasteFromClipboard(mem_data, mem_size, CopyFormat_Base64);
+                ImGui::BeginDisabled(UndoCount == 0);
+                if (ImGui::Button("Undo"))
+                    Undo(mem_data);
+                ImGui::EndDisabled();
+                ImGui::SameLine();
+                ImGui::BeginDisabled(UndoCount == UndoEntries.Size);
+                if (ImGui::Button("Redo"))
+                    Redo(mem_data);
+                ImGui::EndDisabled();
+                if (!LastWriteUndoable)
+                    ImGui::TextDisabled("Last write was too large to be undone (OptUndoMaxSize).");
+            }
 
             ImGui::EndPopup();
         }
+
+        Stats.VtxCount += contents_draw_list->VtxBuffer.Size - contents_vtx_start;
+        Stats.IdxCount += contents_draw_list->IdxBuffer.Size - contents_idx_start;
+        Stats.TimeTotal = (float)(GetStatsTime() - time_start);
+        if (OptShowStatsOverlay)
+            DrawStatsOverlay(ImVec2(contents_pos_start.x + child_width, contents_pos_start.y));
+    }
+
+    // Milliseconds, for Stats. 0.0 when GetTimeFn is not set.
+    double GetStatsTime() const { return GetTimeFn ? GetTimeFn(UserData) * 1000.0 : 0.0; }
+
+    // Display Stats in an overlay window whose top-right corner is at 'pos'
+    void DrawStatsOverlay(const ImVec2& pos)
+    {
+        char window_name[64];
+        ImSnprintf(window_name, IM_ARRAYSIZE(window_name), "Memory Editor Stats##%p", (void*)this);
+        ImGui::SetNextWindowPos(pos, ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(1.0f, 1.0f, 1.0f, 0.5f));
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.0f, 0.0f, 1.0f));
+        ImGui::Begin(window_name, NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoSavedSettings);
+        ImGui::SeparatorText("Memory Editor");
+        ImGui::Text("Lines: %d, Bytes: %d", Stats.LinesDrawn, (int)Stats.BytesDrawn);
+        ImGui::Text("ReadFn: %d, ReadRangeFn: %d, RequestPageFn: %d", Stats.ReadFnCalls, Stats.ReadRangeFnCalls, Stats.RequestPageFnCalls);
+        ImGui::Text("HighlightFn: %d, BgColorFn: %d, ColorRangesFn: %d", Stats.HighlightFnCalls, Stats.BgColorFnCalls, Stats.ColorRangesFnCalls);
+        ImGui::Text("Vertices: %d, Indices: %d", Stats.VtxCount, Stats.IdxCount);
+        if (GetTimeFn == NULL)
+        {
+            ImGui::TextDisabled("Set GetTimeFn to measure times.");
+        }
+        else
+        {
+            ImGui::Text("Update: %.3f ms, Grid: %.3f ms, Ascii: %.3f ms", Stats.TimeUpdate, Stats.TimeGrid, Stats.TimeAscii);
+            ImGui::Text("Minimap: %.3f ms, Footer: %.3f ms", Stats.TimeMinimap, Stats.TimeFooter);
+            ImGui::Text("Total: %.3f ms", Stats.TimeTotal);
+        }
+        ImGui::End();
+        ImGui::PopStyleColor(2);
     }
 
     void DrawOptionsLine(const Sizes& s, void* mem_data, size_t mem_size, size_t base_display_addr)
     {
-        IM_UNUSED(mem_data);
         ImGuiStyle& style = ImGui::GetStyle();
         const char* format_range = OptUpperCaseHex ? "Range %0*" _PRISizeT "X..%0*" _PRISizeT "X" : "Range %0*" _PRISizeT "x..%0*" _PRISizeT "x";
 
@@ -560,17 +1539,39 @@ struct MemoryEditor
             }
         }
 
-        if (GotoAddr != (size_t)-1)
+        ApplyGotoAddr(mem_size);
+
+        if (CompareMemData)
         {
-            if (GotoAddr < mem_size)
+            // Jump to previous/next difference from the address being edited
+            const size_t diff_from_addr = (DataEditingAddr != (size_t)-1) ? DataEditingAddr : (DataPreviewAddr != (size_t)-1) ? DataPreviewAddr : 0;
+            ImGui::SameLine();
+            const bool diff_prev = ImGui::Button("Prev Diff");
+            ImGui::SameLine();
+            const bool diff_next = ImGui::Button("Next Diff");
+            if (diff_prev || diff_next)
             {
-                ImGui::BeginChild("##scrolling");
-                ImGui::SetScrollFromPosY(ImGui::GetCursorStartPos().y + (GotoAddr / Cols) * ImGui::GetTextLineHeight());
-                ImGui::EndChild();
-                DataEditingAddr = DataPreviewAddr = GotoAddr;
-                DataEditingTakeFocus = true;
+                const size_t diff_addr = FindNextDiff((const ImU8*)mem_data, mem_size, diff_from_addr, diff_prev);
+                if (diff_addr != (size_t)-1)
+                {
+                    GotoAddrAndHighlight(diff_addr, diff_addr + 1);
+                    ApplyGotoAddr(mem_size);
+                }
             }
-            GotoAddr = (size_t)-1;
+            if (CompareScanBlock < CompareBlocks.Size)
+            {
+                ImGui::SameLine();
+                ImGui::Text("Comparing %d%%", CompareScanBlock * 100 / CompareBlocks.Size);
+            }
+        }
+
+        if (SearchActive)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Searching %d%%", (int)(SearchMemSize ? (SearchScanAddr * 100.0 / SearchMemSize) : 0));
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Cancel"))
+                SearchActive = false; // Keep results found so far
         }
 
         //if (MouseHovered)
@@ -580,44 +1581,2355 @@ struct MemoryEditor
         //}
     }
 
-    void DrawPreviewLine(const Sizes& s, void* mem_data_void, size_t mem_size, size_t base_display_addr)
+    // [Internal] Virtual scrolling: apply mouse wheel and clamp top line. Return end of visible lines. Called from within child window.
+    size_t UpdateVirtualScroll(const Sizes& s, size_t line_total_count)
     {
-        IM_UNUSED(base_display_addr);
-        ImU8* mem_data = (ImU8*)mem_data_void;
-        ImGuiStyle& style = ImGui::GetStyle();
-        ImGui::AlignTextToFramePadding();
-        ImGui::Text("Preview as:");
-        ImGui::SameLine();
-        ImGui::SetNextItemWidth((s.GlyphWidth * 10.0f) + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
+        ImGui::SetScrollY(0.0f); // Child may be scrolled by focusing an item, we always emit lines from the top
+        const size_t lines_count = (size_t)(ImGui::GetWindowHeight() / s.LineHeight);
+        VirtualScrollLinesCount = (lines_count > 0) ? lines_count : 1;
+        const size_t top_line_max = (line_total_count > VirtualScrollLinesCount) ? line_total_count - VirtualScrollLinesCount : 0;
 
-        static const ImGuiDataType supported_data_types[] = { ImGuiDataType_S8, ImGuiDataType_U8, ImGuiDataType_S16, ImGuiDataType_U16, ImGuiDataType_S32, ImGuiDataType_U32, ImGuiDataType_S64, ImGuiDataType_U64, ImGuiDataType_Float, ImGuiDataType_Double };
-        if (ImGui::BeginCombo("##combo_type", DataTypeGetDesc(PreviewDataType), ImGuiComboFlags_HeightLargest))
+        const float wheel = ImGui::GetIO().MouseWheel;
+        if (wheel != 0.0f && ImGui::IsWindowHovered())
         {
-            for (int n = 0; n < IM_ARRAYSIZE(supported_data_types); n++)
-            {
-                ImGuiDataType data_type = supported_data_types[n];
-                if (ImGui::Selectable(DataTypeGetDesc(data_type), PreviewDataType == data_type))
-                    PreviewDataType = data_type;
-            }
+            size_t wheel_lines = (size_t)((wheel > 0.0f ? wheel : -wheel) * 3.0f);
+            if (wheel_lines < 1)
+                wheel_lines = 1;
+            if (wheel > 0.0f)
+                VirtualScrollTopLine = (VirtualScrollTopLine > wheel_lines) ? VirtualScrollTopLine - wheel_lines : 0;
+            else
+                VirtualScrollTopLine = (top_line_max - VirtualScrollTopLine > wheel_lines) ? VirtualScrollTopLine + wheel_lines : top_line_max;
+        }
+        if (VirtualScrollTopLine > top_line_max)
+            VirtualScrollTopLine = top_line_max;
+
+        // Include partially visible last line
+        return (line_total_count - VirtualScrollTopLine > VirtualScrollLinesCount) ? VirtualScrollTopLine + VirtualScrollLinesCount + 1 : line_total_count;
+    }
+
+    // [Internal] Virtual scrolling: scrollbar on the right side of the child window, mapping its position to the 64-bit top line.
+    void DrawVirtualScrollbar(size_t line_total_count)
+    {
+        ImGuiStyle& style = ImGui::GetStyle();
+        const ImVec2 window_pos = ImGui::GetWindowPos();
+        const ImVec2 window_size = ImGui::GetWindowSize();
+        ImU64 top_line_max = (line_total_count > VirtualScrollLinesCount) ? line_total_count - VirtualScrollLinesCount : 0;
+        ImU64 scroll_value = top_line_max - VirtualScrollTopLine; // Vertical sliders have their max at the top
+        const ImU64 scroll_min = 0;
+        ImGui::SetCursorScreenPos(ImVec2(window_pos.x + window_size.x - style.ScrollbarSize, window_pos.y));
+        ImGui::PushStyleColor(ImGuiCol_FrameBg, ImGui::GetColorU32(ImGuiCol_ScrollbarBg));
+        ImGui::PushStyleColor(ImGuiCol_FrameBgHovered, ImGui::GetColorU32(ImGuiCol_ScrollbarBg));
+        ImGui::PushStyleColor(ImGuiCol_FrameBgActive, ImGui::GetColorU32(ImGuiCol_ScrollbarBg));
+        ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImGui::GetColorU32(ImGuiCol_ScrollbarGrab));
+        ImGui::PushStyleColor(ImGuiCol_SliderGrabActive, ImGui::GetColorU32(ImGuiCol_ScrollbarGrabActive));
+        if (ImGui::VSliderScalar("##virtual_scroll", ImVec2(style.ScrollbarSize, window_size.y), ImGuiDataType_U64, &scroll_value, &scroll_min, &top_line_max, ""))
+            VirtualScrollTopLine = (size_t)(top_line_max - scroll_value);
+        ImGui::PopStyleColor(5);
+    }
+
+    // [Internal] Scroll to GotoAddr and start editing it
+    void ApplyGotoAddr(size_t mem_size)
+    {
+        if (GotoAddr != (size_t)-1)
+        {
+            if (GotoAddr < mem_size && VirtualScroll)
+            {
+                const size_t line = GetLineFromAddr(GotoAddr);
+                VirtualScrollTopLine = (line > VirtualScrollLinesCount / 2) ? line - VirtualScrollLinesCount / 2 : 0;
+                DataEditingAddr = DataPreviewAddr = GotoAddr;
+                DataEditingTakeFocus = true;
+            }
+            else if (GotoAddr < mem_size)
+            {
+                ImGui::BeginChild("##scrolling");
+                ImGui::SetScrollFromPosY(ImGui::GetCursorStartPos().y + GetLineFromAddr(GotoAddr) * CachedSizes.LineHeight);
+                ImGui::EndChild();
+                DataEditingAddr = DataPreviewAddr = GotoAddr;
+                DataEditingTakeFocus = true;
+            }
+            GotoAddr = (size_t)-1;
+        }
+    }
+
+    void DrawSearchLine(const Sizes& s, void* mem_data, size_t mem_size, size_t base_display_addr)
+    {
+        IM_UNUSED(mem_data);
+        IM_UNUSED(base_display_addr);
+        ImGuiStyle& style = ImGui::GetStyle();
+
+        ImGui::SetNextItemWidth((s.GlyphWidth * 5.0f) + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x + ImGui::GetFrameHeight());
+        ImGui::Combo("##search_mode", &SearchInputMode, "Hex\0Text\0\0");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(s.GlyphWidth * 24.0f + style.FramePadding.x * 2.0f);
+        bool search_start = ImGui::InputText("##search", SearchInputBuf, IM_ARRAYSIZE(SearchInputBuf), ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        search_start |= ImGui::Button("Find");
+        if (search_start)
+            StartSearch(SearchInputBuf, (SearchMode)SearchInputMode, mem_size);
+
+        // Jump to previous/next result from the address being edited
+        const size_t search_from_addr = (DataEditingAddr != (size_t)-1) ? DataEditingAddr : (DataPreviewAddr != (size_t)-1) ? DataPreviewAddr : 0;
+        ImGui::SameLine();
+        ImGui::BeginDisabled(SearchResults.Size == 0);
+        const bool search_prev = ImGui::ArrowButton("##search_prev", ImGuiDir_Up);
+        ImGui::SameLine();
+        const bool search_next = ImGui::ArrowButton("##search_next", ImGuiDir_Down);
+        ImGui::EndDisabled();
+        if (search_prev || search_next)
+        {
+            const size_t result_addr = FindNextSearchResult(search_from_addr, search_prev);
+            if (result_addr != (size_t)-1)
+                GotoAddrAndHighlight(result_addr, result_addr + SearchPattern.Size);
+        }
+
+        ImGui::SameLine();
+        if (SearchActive)
+            ImGui::Text("%d results (%d%%)", SearchResults.Size, (int)(SearchMemSize ? (SearchScanAddr * 100.0 / SearchMemSize) : 0));
+        else if (SearchPattern.Size > 0)
+            ImGui::Text("%d results%s", SearchResults.Size, (SearchResults.Size >= OptSearchMaxResults) ? " (max)" : "");
+
+        ApplyGotoAddr(mem_size);
+    }
+
+    void DrawPreviewLine(const Sizes& s, void* mem_data_void, size_t mem_size, size_t base_display_addr)
+    {
+        IM_UNUSED(base_display_addr);
+        ImU8* mem_data = (ImU8*)mem_data_void;
+        ImGuiStyle& style = ImGui::GetStyle();
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("Preview as:");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth((s.GlyphWidth * 10.0f) + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
+
+        static const ImGuiDataType supported_data_types[] = { ImGuiDataType_S8, ImGuiDataType_U8, ImGuiDataType_S16, ImGuiDataType_U16, ImGuiDataType_S32, ImGuiDataType_U32, ImGuiDataType_S64, ImGuiDataType_U64, ImGuiDataType_Float, ImGuiDataType_Double };
+        if (ImGui::BeginCombo("##combo_type", DataTypeGetDesc(PreviewDataType), ImGuiComboFlags_HeightLargest))
+        {
+            for (int n = 0; n < IM_ARRAYSIZE(supported_data_types); n++)
+            {
+                ImGuiDataType data_type = supported_data_types[n];
+                if (ImGui::Selectable(DataTypeGetDesc(data_type), PreviewDataType == data_type))
+                {
+                    if (OptDisplayMode == DisplayMode_Words && PreviewDataType != data_type)
+                        ContentsWidthChanged = true;
+                    PreviewDataType = data_type;
+                }
+            }
             ImGui::EndCombo();
         }
         ImGui::SameLine();
-        ImGui::SetNextItemWidth((s.GlyphWidth * 6.0f) + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
-        ImGui::Combo("##combo_endianness", &PreviewEndianness, "LE\0BE\0\0");
+        ImGui::SetNextItemWidth((s.GlyphWidth * 6.0f) + style.FramePadding.x * 2.0f + style.ItemInnerSpacing.x);
+        ImGui::Combo("##combo_endianness", &PreviewEndianness, "LE\0BE\0\0");
+
+        char buf[128] = "";
+        float x = s.GlyphWidth * 6.0f;
+        bool has_value = DataPreviewAddr != (size_t)-1;
+        if (has_value && RequestPageFn)
+            for (size_t addr = DataPreviewAddr, addr_end = DataPreviewAddr + DataTypeGetSize(PreviewDataType); addr < addr_end && addr < mem_size; addr++)
+                if (GetByteStatus(addr) != ByteStatus_Ok)
+                    has_value = false;
+        if (has_value)
+            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Dec, buf, (size_t)IM_ARRAYSIZE(buf));
+        ImGui::Text("Dec"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
+        if (has_value)
+            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Hex, buf, (size_t)IM_ARRAYSIZE(buf));
+        ImGui::Text("Hex"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
+        if (has_value)
+            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Bin, buf, (size_t)IM_ARRAYSIZE(buf));
+        buf[IM_ARRAYSIZE(buf) - 1] = 0;
+        ImGui::Text("Bin"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
+    }
+
+    // [Internal] Read bytes from the visible bytes buffer when possible, otherwise through ReadRangeFn, ReadFn or direct memory access.
+    void ReadBytes(const ImU8* mem_data, size_t addr, ImU8* out_buf, size_t size) const
+    {
+        if (addr >= ReadBufAddr && addr + size <= ReadBufAddr + ReadBuf.Size)
+            memcpy(out_buf, ReadBuf.Data + (addr - ReadBufAddr), size);
+        else
+            ReadBytesFromSource(mem_data, addr, out_buf, size);
+    }
+
+    // [Internal] Unreadable bytes outside of regions are set to 0.
+    void ReadBytesFromSource(const ImU8* mem_data, size_t addr, ImU8* out_buf, size_t size) const
+    {
+        if (Regions.Size == 0)
+        {
+            ReadBytesFromHandlers(mem_data, addr, out_buf, size);
+            return;
+        }
+        const size_t addr_end = addr + size;
+        for (int region_n = FindRegionIndex(addr); addr < addr_end; region_n++)
+        {
+            const Region* region = (region_n < Regions.Size) ? &Regions[region_n] : NULL;
+            const size_t readable_min = region ? ((region->Addr > addr) ? region->Addr : addr) : addr_end;
+            const size_t readable_max = region ? ((region->Addr + region->Size < addr_end) ? region->Addr + region->Size : addr_end) : addr_end;
+            if (readable_min >= addr_end)
+            {
+                memset(out_buf, 0, addr_end - addr);
+                break;
+            }
+            memset(out_buf, 0, readable_min - addr);
+            if (region->Flags & RegionFlags_Unreadable)
+                memset(out_buf + (readable_min - addr), 0, readable_max - readable_min);
+            else
+                ReadBytesFromHandlers(mem_data, readable_min, out_buf + (readable_min - addr), readable_max - readable_min);
+            out_buf += readable_max - addr;
+            addr = readable_max;
+        }
+    }
+
+    void ReadBytesFromHandlers(const ImU8* mem_data, size_t addr, ImU8* out_buf, size_t size) const
+    {
+        if (RequestPageFn)
+            ReadBytesFromPages(addr, out_buf, size, NULL);
+        else if (ReadRangeFn)
+        {
+            Stats.ReadRangeFnCalls++;
+            ReadRangeFn(mem_data, addr, out_buf, size, UserData);
+        }
+        else if (ReadFn)
+        {
+            Stats.ReadFnCalls += (int)size;
+            for (size_t n = 0; n < size; n++)
+                out_buf[n] = ReadFn(mem_data, addr + n, UserData);
+        }
+        else
+            memcpy(out_buf, mem_data + addr, size);
+    }
+
+    ImU8 ReadByte(const ImU8* mem_data, size_t addr) const
+    {
+        if (addr >= ReadBufAddr && addr < ReadBufAddr + ReadBuf.Size)
+            return ReadBuf.Data[addr - ReadBufAddr];
+        ImU8 b;
+        ReadBytes(mem_data, addr, &b, 1);
+        return b;
+    }
+
+    // [Internal] Fill ReadBuf with bytes in the [addr_min, addr_max) range (e.g. visible lines of the clipper).
+    void FetchVisibleBytes(const ImU8* mem_data, size_t mem_size, size_t addr_min, size_t addr_max)
+    {
+        if (addr_max > mem_size)
+            addr_max = mem_size;
+        ReadBuf.resize(0);
+        ReadBufStatus.resize(0);
+        if (addr_min >= addr_max)
+            return;
+        ReadBuf.resize((int)(addr_max - addr_min));
+        ReadBufStatus.resize(ReadBuf.Size);
+        ReadBufAddr = addr_min;
+        if (RequestPageFn)
+        {
+            // Request visible pages first, then prefetch ahead and behind
+            const size_t prefetch_size = OptPageSize * (size_t)OptPagePrefetchCount;
+            RequestPages(mem_data, mem_size, addr_min, addr_max);
+            RequestPages(mem_data, mem_size, addr_max, addr_max + prefetch_size);
+            RequestPages(mem_data, mem_size, addr_min > prefetch_size ? addr_min - prefetch_size : 0, addr_min);
+            ReadBytesFromPages(addr_min, ReadBuf.Data, (size_t)ReadBuf.Size, ReadBufStatus.Data);
+        }
+        else
+        {
+            ReadBytesFromSource(mem_data, addr_min, ReadBuf.Data, (size_t)ReadBuf.Size);
+            memset(ReadBufStatus.Data, ByteStatus_Ok, (size_t)ReadBufStatus.Size);
+        }
+        if (Regions.Size > 0)
+            for (int n = 0; n < ReadBufStatus.Size; n++)
+                if (!IsAddrReadable(addr_min + n))
+                    ReadBufStatus.Data[n] = ByteStatus_Unreadable;
+    }
+
+    int GetByteStatus(size_t addr) const
+    {
+        if (addr >= ReadBufAddr && addr < ReadBufAddr + ReadBufStatus.Size)
+            return ReadBufStatus.Data[addr - ReadBufAddr];
+        if (Regions.Size > 0 && !IsAddrReadable(addr))
+            return ByteStatus_Unreadable;
+        if (RequestPageFn)
+        {
+            const PageEntry* page = FindPage(addr - addr % OptPageSize);
+            return page ? page->Status : ByteStatus_Pending;
+        }
+        return ByteStatus_Ok;
+    }
+
+    // Write bytes through WriteRangeFn, WriteFn or direct memory access, recording them in the undo journal.
+    // Writes larger than OptUndoMaxSize / 2 are not recorded (see IsWriteUndoable()), LastWriteUndoable is then set to false.
+    // Return false if nothing was written (read-only editor or region, or RequestPageFn bytes not available: their old values couldn't be recorded).
+    bool WriteBytes(void* mem_data, size_t addr, const ImU8* buf, size_t size)
+    {
+        if (ReadOnly || size == 0)
+            return false;
+        for (size_t n = 0; n < size; n++)
+            if (!IsAddrWritable(addr + n) || (RequestPageFn && GetByteStatus(addr + n) != ByteStatus_Ok))
+                return false;
+        LastWriteUndoable = IsWriteUndoable(size);
+        RecordUndo((const ImU8*)mem_data, addr, buf, size);
+        WriteBytesToSource((ImU8*)mem_data, addr, buf, size);
+        return true;
+    }
+
+    // [Internal] Write without recording in undo journal.
+    void WriteBytesToSource(ImU8* mem_data, size_t addr, const ImU8* buf, size_t size)
+    {
+        if (WriteRangeFn)
+            WriteRangeFn(mem_data, addr, buf, size, UserData);
+        else if (WriteFn)
+            for (size_t n = 0; n < size; n++)
+                WriteFn(mem_data, addr + n, buf[n], UserData);
+        else
+            memcpy(mem_data + addr, buf, size);
+        for (size_t n = 0; n < size; n++)
+            UpdateCachedByte(addr + n, buf[n]);
+        if (MinimapBlocks.Size > 0)
+            InvalidateMinimap(addr, addr + size);
+        if (CompareBlocks.Size > 0)
+            InvalidateCompareBlocks(addr, addr + size);
+    }
+
+    // [Internal] OptNibbleEditing: apply hex digits typed this frame to DataEditingAddr, moving to next byte after each low nibble.
+    // Called before lines are drawn, so many digits may be applied per frame.
+    void UpdateNibbleEditing(ImU8* mem_data, size_t mem_size)
+    {
+        if (!ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) || ImGui::IsAnyItemActive())
+            return;
+        const ImGuiIO& io = ImGui::GetIO();
+        for (int n = 0; n < io.InputQueueCharacters.Size && DataEditingAddr < mem_size; n++)
+        {
+            const unsigned int c = (unsigned int)io.InputQueueCharacters[n];
+            const int value = (c < 128) ? HexDigitValue((char)c) : -1;
+            if (value < 0)
+                continue;
+            // Ignore digit (cursor doesn't move) on read-only editor or region, or unreadable/pending byte
+            if (ReadOnly || GetByteStatus(DataEditingAddr) != ByteStatus_Ok)
+                continue;
+            const bool low_nibble = (DataEditingLowNibbleAddr == DataEditingAddr);
+            const ImU8 b = ReadByte(mem_data, DataEditingAddr);
+            const ImU8 new_b = low_nibble ? (ImU8)((b & 0xF0) | value) : (ImU8)((b & 0x0F) | (value << 4));
+            if (!WriteBytes(mem_data, DataEditingAddr, &new_b, 1))
+                continue;
+            if (!low_nibble)
+                DataEditingLowNibbleAddr = DataEditingAddr;
+            else if (DataEditingAddr + 1 < mem_size)
+                MoveNibbleEditingAddr(DataEditingAddr + 1);
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_Backspace))
+        {
+            if (DataEditingLowNibbleAddr == DataEditingAddr)
+                DataEditingLowNibbleAddr = (size_t)-1;
+            else if (DataEditingAddr > 0)
+            {
+                MoveNibbleEditingAddr(DataEditingAddr - 1);
+                DataEditingLowNibbleAddr = DataEditingAddr;
+            }
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Enter) && DataEditingAddr + 1 < mem_size)
+        {
+            MoveNibbleEditingAddr(DataEditingAddr + 1);
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_Escape))
+        {
+            DataEditingAddr = (size_t)-1;
+        }
+    }
+
+    void MoveNibbleEditingAddr(size_t addr)
+    {
+        DataEditingAddr = DataPreviewAddr = addr;
+        DataEditingLowNibbleAddr = (size_t)-1;
+        DataEditingTakeFocus = true; // Scroll to it
+    }
+
+    // Selection
+    bool HasSelection() const   { return SelectMin < SelectMax && SelectMax != (size_t)-1; }
+    void SelectRange(size_t addr_min, size_t addr_max) { SelectMin = addr_min; SelectMax = addr_max; SelectAnchorAddr = addr_min; }
+    void ClearSelection()       { SelectMin = SelectMax = (size_t)-1; }
+
+    // [Internal] Mouse drag or shift+click to select. Called after all lines are submitted, using MouseHoveredAddr.
+    void UpdateSelection()
+    {
+        if (!ImGui::IsMouseDown(0))
+            SelectDragging = false;
+        if (!MouseHovered)
+            return;
+        if (ImGui::IsMouseClicked(0))
+        {
+            if (ImGui::GetIO().KeyShift && (SelectAnchorAddr != (size_t)-1 || DataEditingAddr != (size_t)-1))
+            {
+                if (SelectAnchorAddr == (size_t)-1)
+                    SelectAnchorAddr = DataEditingAddr;
+            }
+            else
+            {
+                SelectAnchorAddr = MouseHoveredAddr;
+                ClearSelection();
+                SelectDragging = true;
+                return;
+            }
+        }
+        else if (!SelectDragging || MouseHoveredAddr == SelectAnchorAddr)
+        {
+            return;
+        }
+        SelectMin = (SelectAnchorAddr < MouseHoveredAddr) ? SelectAnchorAddr : MouseHoveredAddr;
+        SelectMax = ((SelectAnchorAddr < MouseHoveredAddr) ? MouseHoveredAddr : SelectAnchorAddr) + 1;
+    }
+
+    // Copy selected bytes to clipboard. Bytes are read and encoded in chunks directly into the final text buffer, which is freed after SetClipboardText().
+    // Peak memory is that buffer + the copy made by the platform clipboard handler. Return false if selection is larger than GetCopyMaxSize().
+    bool CopySelectionToClipboard(const void* mem_data, CopyFormat format)
+    {
+        if (!HasSelection() || SelectMax - SelectMin > GetCopyMaxSize(format))
+            return false;
+        CopyFormatDefault = format;
+        EncodeBytes((const ImU8*)mem_data, SelectMin, SelectMax - SelectMin, format, &ClipboardBuf);
+        ClipboardCopyLen = strlen(ClipboardBuf.Data);
+        ClipboardCopyHash = HashText(ClipboardBuf.Data, ClipboardCopyLen);
+        ImGui::SetClipboardText(ClipboardBuf.Data);
+        ClipboardBuf.clear();
+        return true;
+    }
+
+    // Maximum number of bytes which can be copied in a given format: text is stored in an ImVector<char>, its size must fit in an int.
+    static size_t GetCopyMaxSize(CopyFormat format)
+    {
+        const size_t text_max_size = 0x7FFFFFFF - 2; // EncodeHex() writes 1 byte past its output + terminator
+        if (format == CopyFormat_Hex)
+            return text_max_size / 3;
+        if (format == CopyFormat_CArray)
+            return text_max_size / 6;
+        return (text_max_size - 1) / 4 * 3;
+    }
+
+    // Paste clipboard contents (hex, C array or base64) at start of selection or at the address being edited.
+    // Text copied by this editor is decoded with the format it was copied with. Otherwise format is guessed, unless 'format' is specified.
+    // Return number of bytes written.
+    size_t PasteFromClipboard(void* mem_data, size_t mem_size, int format = -1)
+    {
+        const size_t addr = HasSelection() ? SelectMin : DataEditingAddr;
+        const char* text = ImGui::GetClipboardText();
+        if (ReadOnly || addr >= mem_size || text == NULL)
+            return 0;
+        if (format < 0)
+        {
+            const size_t text_len = strlen(text);
+            if (text_len == ClipboardCopyLen && HashText(text, text_len) == ClipboardCopyHash)
+                format = CopyFormatDefault;
+        }
+        if (!DecodeBytes(text, &PasteBuf, format))
+            return 0;
+        const size_t size = (mem_size - addr < (size_t)PasteBuf.Size) ? mem_size - addr : (size_t)PasteBuf.Size;
+        UndoMergeAllowed = false;
+        const bool written = WriteBytes(mem_data, addr, PasteBuf.Data, size);
+        PasteBuf.clear();
+        if (!written)
+            return 0;
+        SelectRange(addr, addr + size);
+        DataEditingTakeFocus = true; // Refresh InputText contents
+        return size;
+    }
+
+    // Encode 'size' bytes read from 'addr' into zero-terminated 'out_text'. The output buffer is allocated once at its final size.
+    // 'size' must not be larger than GetCopyMaxSize(format).
+    void EncodeBytes(const ImU8* mem_data, size_t addr, size_t size, CopyFormat format, ImVector<char>* out_text)
+    {
+        IM_ASSERT(size <= GetCopyMaxSize(format));
+        const char* hex_lut = GetHexLut(OptUpperCaseHex);
+        const size_t text_size = (format == CopyFormat_Hex) ? size * 3 : (format == CopyFormat_CArray) ? size * 6 : (size + 2) / 3 * 4 + 1;
+        out_text->resize((int)text_size + 1); // EncodeHex() writes 1 byte past its output
+        char* dst = out_text->Data;
+        const size_t chunk_size = 3 * 16 * 1024; // Multiple of 3 so base64 chunks don't need padding
+        ClipboardChunkBuf.resize((int)chunk_size);
+        for (size_t done = 0; done < size; )
+        {
+            const size_t count = (size - done < chunk_size) ? size - done : chunk_size;
+            const ImU8* src = ClipboardChunkBuf.Data;
+            ReadBytes(mem_data, addr + done, ClipboardChunkBuf.Data, count);
+            if (format == CopyFormat_Hex)
+                dst = EncodeHex(src, count, OptUpperCaseHex, dst);
+            else if (format == CopyFormat_CArray)
+                dst = EncodeCArray(src, count, done, hex_lut, dst);
+            else
+                dst = EncodeBase64(src, count, dst);
+            done += count;
+        }
+        // Replace trailing separator with terminator
+        if (format == CopyFormat_Base64 || size == 0)
+            *dst = 0;
+        else
+            dst[(format == CopyFormat_CArray) ? -2 : -1] = 0;
+    }
+
+    // [Internal] Encoders write a separator after each byte: "XX " for hex, "0xXX, " or "0xXX,\n" every 16 bytes for C array.
+    // Hex uses a single 4 bytes store per byte ("XX " + 1 byte overwritten by next store), 'dst' must have 1 extra byte.
+    static char* EncodeHex(const ImU8* src, size_t count, bool upper_case, char* dst)
+    {
+        static ImU32 lut[2][256];
+        static bool lut_initialized = false;
+        if (!lut_initialized)
+        {
+            for (int lut_n = 0; lut_n < 2; lut_n++)
+                for (int b = 0; b < 256; b++)
+                {
+                    const char* hex_lut = GetHexLut(lut_n == 1);
+                    const char entry[4] = { hex_lut[b * 2], hex_lut[b * 2 + 1], ' ', 0 };
+                    memcpy(&lut[lut_n][b], entry, 4);
+                }
+            lut_initialized = true;
+        }
+        const ImU32* lut_entries = lut[upper_case ? 1 : 0];
+        for (size_t n = 0; n < count; n++, dst += 3)
+            memcpy(dst, &lut_entries[src[n]], 4);
+        return dst;
+    }
+
+    static char* EncodeCArray(const ImU8* src, size_t count, size_t index, const char* hex_lut, char* dst)
+    {
+        for (size_t n = 0; n < count; n++, dst += 6)
+        {
+            dst[0] = '0';
+            dst[1] = 'x';
+            memcpy(dst + 2, hex_lut + src[n] * 2, 2);
+            dst[4] = ',';
+            dst[5] = ((index + n) % 16 == 15) ? '\n' : ' ';
+        }
+        return dst;
+    }
+
+    static char* EncodeBase64(const ImU8* src, size_t count, char* dst)
+    {
+        static const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        size_t n = 0;
+        for (; n + 3 <= count; n += 3, dst += 4)
+        {
+            const unsigned int v = (src[n] << 16) | (src[n + 1] << 8) | src[n + 2];
+            dst[0] = chars[(v >> 18) & 63];
+            dst[1] = chars[(v >> 12) & 63];
+            dst[2] = chars[(v >> 6) & 63];
+            dst[3] = chars[v & 63];
+        }
+        if (n < count)
+        {
+            const unsigned int v = (src[n] << 16) | ((n + 1 < count) ? (src[n + 1] << 8) : 0);
+            dst[0] = chars[(v >> 18) & 63];
+            dst[1] = chars[(v >> 12) & 63];
+            dst[2] = (n + 1 < count) ? chars[(v >> 6) & 63] : '=';
+            dst[3] = '=';
+            dst += 4;
+        }
+        return dst;
+    }
+
+    // Decode hex ("DEADBEEF", "DE AD BE EF"), C array ("0xDE, 0xAD") or base64 text. Return false if text is invalid.
+    // With format == -1, hex takes precedence when text is valid in both (e.g. "AAAA" is decoded as hex, specify CopyFormat_Base64 to avoid that).
+    static bool DecodeBytes(const char* text, ImVector<ImU8>* out_bytes, int format = -1)
+    {
+        if (format == CopyFormat_Base64)
+            return DecodeBase64(text, out_bytes);
+        if (format >= 0)
+            return DecodeHex(text, out_bytes); // Also decodes C arrays
+        return DecodeHex(text, out_bytes) || DecodeBase64(text, out_bytes);
+    }
+
+    // [Internal] FNV-1a
+    static ImU32 HashText(const char* text, size_t len)
+    {
+        ImU32 hash = 2166136261u;
+        for (size_t n = 0; n < len; n++)
+            hash = (hash ^ (ImU8)text[n]) * 16777619u;
+        return hash;
+    }
+
+    static int HexDigitValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool DecodeHex(const char* text, ImVector<ImU8>* out_bytes)
+    {
+        out_bytes->resize(0);
+        out_bytes->reserve((int)(strlen(text) / 2));
+        for (const char* p = text; *p; )
+        {
+            if (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == ',' || *p == ';' || *p == '{' || *p == '}')
+            {
+                p++;
+                continue;
+            }
+            if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X') && HexDigitValue(p[2]) >= 0)
+            {
+                // C literal: 1 or 2 digits
+                p += 2;
+                int value = HexDigitValue(*p++);
+                if (HexDigitValue(*p) >= 0)
+                    value = (value << 4) | HexDigitValue(*p++);
+                out_bytes->push_back((ImU8)value);
+                continue;
+            }
+            const int hi = HexDigitValue(p[0]);
+            const int lo = (hi >= 0) ? HexDigitValue(p[1]) : -1;
+            if (lo < 0)
+                return false;
+            out_bytes->push_back((ImU8)((hi << 4) | lo));
+            p += 2;
+        }
+        return out_bytes->Size > 0;
+    }
+
+    static bool DecodeBase64(const char* text, ImVector<ImU8>* out_bytes)
+    {
+        out_bytes->resize(0);
+        out_bytes->reserve((int)(strlen(text) / 4 * 3));
+        unsigned int acc = 0;
+        int acc_bits = 0;
+        for (const char* p = text; *p && *p != '='; p++)
+        {
+            const char c = *p;
+            int v;
+            if (c >= 'A' && c <= 'Z')       v = c - 'A';
+            else if (c >= 'a' && c <= 'z')  v = c - 'a' + 26;
+            else if (c >= '0' && c <= '9')  v = c - '0' + 52;
+            else if (c == '+' || c == '-')  v = 62;
+            else if (c == '/' || c == '_')  v = 63;
+            else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
+            else return false;
+            acc = (acc << 6) | (unsigned int)v;
+            acc_bits += 6;
+            if (acc_bits >= 8)
+            {
+                acc_bits -= 8;
+                out_bytes->push_back((ImU8)(acc >> acc_bits));
+                acc &= (1u << acc_bits) - 1;
+            }
+        }
+        return out_bytes->Size > 0;
+    }
+
+    // Undo journal
+    // - Each entry stores old and new values of a contiguous range. Successive single byte edits at following addresses are merged.
+    // - Undo/Redo write through the same handlers as edits, and move the editing cursor to the modified range.
+    //   They return false and leave the journal unchanged when the editor (ReadOnly) or the range (SetRegions()) is not writable.
+    bool CanUndo() const        { return UndoCount > 0; }
+    bool CanRedo() const        { return UndoCount < UndoEntries.Size; }
+    void ClearUndo()            { UndoEntries.resize(0); UndoData.resize(0); UndoCount = 0; UndoMergeAllowed = false; }
+    bool IsWriteUndoable(size_t size) const { return size * 2 <= OptUndoMaxSize; } // Larger writes are not recorded, and previous entries overlapping them are discarded. Other entries are kept.
+
+    bool Undo(void* mem_data)   { return ApplyUndoEntry((ImU8*)mem_data, true); }
+    bool Redo(void* mem_data)   { return ApplyUndoEntry((ImU8*)mem_data, false); }
+
+    // [Internal]
+    bool ApplyUndoEntry(ImU8* mem_data, bool undo)
+    {
+        if (ReadOnly || (undo ? !CanUndo() : !CanRedo()))
+            return false;
+        const UndoEntry& entry = UndoEntries[undo ? UndoCount - 1 : UndoCount];
+        for (size_t n = 0; n < entry.Size; n++)
+            if (!IsAddrWritable(entry.Addr + n))
+                return false;
+        UndoCount += undo ? -1 : +1;
+        UndoScratch.resize((int)entry.Size);
+        const ImU8* pairs = UndoData.Data + entry.DataOffset + (undo ? 0 : 1);
+        for (size_t n = 0; n < entry.Size; n++)
+            UndoScratch.Data[n] = pairs[n * 2];
+        WriteBytesToSource(mem_data, entry.Addr, UndoScratch.Data, entry.Size);
+        UndoMergeAllowed = false;
+        DataEditingAddr = DataPreviewAddr = entry.Addr;
+        DataEditingTakeFocus = true;
+        return true;
+    }
+
+    // [Internal] Record old and new values of a write, before it happens.
+    void RecordUndo(const ImU8* mem_data, size_t addr, const ImU8* buf, size_t size)
+    {
+        // Discard entries which could be redone
+        if (UndoCount < UndoEntries.Size)
+        {
+            UndoData.resize((UndoCount > 0) ? (int)(UndoEntries[UndoCount - 1].DataOffset + UndoEntries[UndoCount - 1].Size * 2) : 0);
+            UndoEntries.resize(UndoCount);
+            UndoMergeAllowed = false;
+        }
+        if (!IsWriteUndoable(size))
+        {
+            // Too large to be undone: only discard entries touching the written range, they couldn't be undone or redone correctly anymore
+            for (int n = UndoEntries.Size - 1; n >= 0; n--)
+                if (UndoEntries[n].Addr < addr + size && addr < UndoEntries[n].Addr + UndoEntries[n].Size)
+                    EraseUndoEntry(n);
+            UndoMergeAllowed = false;
+            return;
+        }
+        UndoEntry* last_entry = (UndoCount > 0) ? &UndoEntries[UndoCount - 1] : NULL;
+        if (UndoMergeAllowed && size == 1 && last_entry && last_entry->Addr + last_entry->Size == addr + 1)
+        {
+            UndoData[(int)(last_entry->DataOffset + last_entry->Size * 2 - 1)] = buf[0]; // Writing last byte again (e.g. its second nibble): only update its new value
+            return;
+        }
+
+        const size_t data_offset = (size_t)UndoData.Size;
+        UndoData.resize((int)(data_offset + size * 2));
+        ImU8* pairs = UndoData.Data + data_offset;
+        UndoScratch.resize((int)size);
+        ReadBytes(mem_data, addr, UndoScratch.Data, size);
+        for (size_t n = 0; n < size; n++)
+        {
+            pairs[n * 2 + 0] = UndoScratch.Data[n];
+            pairs[n * 2 + 1] = buf[n];
+        }
+
+        if (UndoMergeAllowed && size == 1 && last_entry && last_entry->Addr + last_entry->Size == addr)
+        {
+            last_entry->Size += size; // Pairs are already stored right after last entry's pairs
+        }
+        else
+        {
+            UndoEntry entry;
+            entry.Addr = addr;
+            entry.Size = size;
+            entry.DataOffset = data_offset;
+            UndoEntries.push_back(entry);
+            UndoCount++;
+        }
+        UndoMergeAllowed = (size == 1);
+
+        // Discard oldest entries when exceeding maximum size
+        if ((size_t)UndoData.Size > OptUndoMaxSize)
+        {
+            int discard_count = 0;
+            size_t discard_size = 0;
+            while (discard_count < UndoEntries.Size - 1 && (size_t)UndoData.Size - discard_size > OptUndoMaxSize)
+                discard_size += UndoEntries[discard_count++].Size * 2;
+            memmove(UndoData.Data, UndoData.Data + discard_size, (size_t)UndoData.Size - discard_size);
+            UndoData.resize((int)((size_t)UndoData.Size - discard_size));
+            UndoEntries.erase(UndoEntries.Data, UndoEntries.Data + discard_count);
+            for (UndoEntry& entry : UndoEntries)
+                entry.DataOffset -= discard_size;
+            UndoCount -= discard_count;
+        }
+    }
+
+    // [Internal] Erase an entry and its pairs, keeping following entries.
+    void EraseUndoEntry(int entry_n)
+    {
+        const size_t data_offset = UndoEntries[entry_n].DataOffset;
+        const size_t data_size = UndoEntries[entry_n].Size * 2;
+        memmove(UndoData.Data + data_offset, UndoData.Data + data_offset + data_size, (size_t)UndoData.Size - data_offset - data_size);
+        UndoData.resize((int)((size_t)UndoData.Size - data_size));
+        UndoEntries.erase(UndoEntries.Data + entry_n);
+        for (int n = entry_n; n < UndoEntries.Size; n++)
+            UndoEntries[n].DataOffset -= data_size;
+        if (entry_n < UndoCount)
+            UndoCount--;
+    }
+
+    // [Internal] Keep cached copies in sync after writing a byte.
+    void UpdateCachedByte(size_t addr, ImU8 b)
+    {
+        if (addr >= ReadBufAddr && addr < ReadBufAddr + ReadBuf.Size)
+            ReadBuf[(int)(addr - ReadBufAddr)] = b;
+        if (RequestPageFn)
+            if (PageEntry* page = FindPage(addr - addr % OptPageSize))
+                if (page->Status == ByteStatus_Ok)
+                    PagesData[(int)((size_t)page->Slot * OptPageSize + addr % OptPageSize)] = b;
+    }
+
+    // Page cache used with RequestPageFn.
+    // - Call SetPageData() or SetPageUnreadable() when a requested page completes. This may be done from within RequestPageFn.
+    //   Those functions are not thread-safe: if your requests complete on another thread, queue completions and apply them on the thread calling DrawContents().
+    // - Unreadable pages are not requested again until they are invalidated.
+    // - Call InvalidatePages() when target memory changed, pages will be requested again when visible.
+    void SetPageData(size_t page_addr, const void* data, size_t size)
+    {
+        IM_ASSERT(page_addr % OptPageSize == 0 && size <= OptPageSize);
+        PageEntry* page = FindPage(page_addr);
+        if (page == NULL || PagesFreeSlots.Size + (page->Slot >= 0 ? 1 : 0) == 0)
+            return; // Evicted or invalidated since requested
+        if (page->Slot < 0)
+        {
+            page->Slot = PagesFreeSlots.back();
+            PagesFreeSlots.pop_back();
+        }
+        memcpy(PagesData.Data + (size_t)page->Slot * OptPageSize, data, size);
+        page->Status = ByteStatus_Ok;
+    }
+
+    void SetPageUnreadable(size_t page_addr)
+    {
+        IM_ASSERT(page_addr % OptPageSize == 0);
+        if (PageEntry* page = FindPage(page_addr))
+        {
+            if (page->Slot >= 0)
+                PagesFreeSlots.push_back(page->Slot);
+            page->Slot = -1;
+            page->Status = ByteStatus_Unreadable;
+        }
+    }
+
+    void InvalidatePages(size_t addr_min = 0, size_t addr_max = (size_t)-1)
+    {
+        for (int n = Pages.Size - 1; n >= 0; n--)
+            if (Pages[n].Addr < addr_max && Pages[n].Addr + OptPageSize > addr_min)
+            {
+                if (Pages[n].Slot >= 0)
+                    PagesFreeSlots.push_back(Pages[n].Slot);
+                Pages.erase(Pages.Data + n);
+            }
+    }
+
+    // [Internal]
+    int FindPageIndex(size_t page_addr) const
+    {
+        int lo = 0, hi = Pages.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) >> 1;
+            if (Pages.Data[mid].Addr < page_addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    PageEntry* FindPage(size_t page_addr) const
+    {
+        const int idx = FindPageIndex(page_addr);
+        return (idx < Pages.Size && Pages.Data[idx].Addr == page_addr) ? &Pages.Data[idx] : NULL;
+    }
+
+    void ReadBytesFromPages(size_t addr, ImU8* out_buf, size_t size, ImU8* out_status) const
+    {
+        while (size > 0)
+        {
+            const size_t page_off = addr % OptPageSize;
+            const size_t chunk_size = (OptPageSize - page_off < size) ? OptPageSize - page_off : size;
+            const PageEntry* page = FindPage(addr - page_off);
+            const int status = page ? page->Status : ByteStatus_Pending;
+            if (status == ByteStatus_Ok)
+                memcpy(out_buf, PagesData.Data + (size_t)page->Slot * OptPageSize + page_off, chunk_size);
+            else
+                memset(out_buf, 0, chunk_size);
+            if (out_status)
+                memset(out_status, status, chunk_size);
+            out_buf += chunk_size;
+            if (out_status)
+                out_status += chunk_size;
+            addr += chunk_size;
+            size -= chunk_size;
+        }
+    }
+
+    // [Internal] Call RequestPageFn for pages in the [addr_min, addr_max) range which are not already in cache.
+    void RequestPages(const ImU8* mem_data, size_t mem_size, size_t addr_min, size_t addr_max)
+    {
+        if (OptPageSize == 0 || OptPageCacheMaxCount < 1)
+            return;
+        if (PagesData.Size != (int)(OptPageSize * (size_t)OptPageCacheMaxCount))
+        {
+            // (Re)create cache storage
+            Pages.resize(0);
+            PagesData.resize((int)(OptPageSize * (size_t)OptPageCacheMaxCount));
+            PagesFreeSlots.resize(0);
+            for (int n = OptPageCacheMaxCount - 1; n >= 0; n--)
+                PagesFreeSlots.push_back(n);
+        }
+        if (addr_max > mem_size)
+            addr_max = mem_size;
+
+        const int frame = ImGui::GetFrameCount();
+        for (size_t page_addr = addr_min - addr_min % OptPageSize; page_addr < addr_max; page_addr += OptPageSize)
+        {
+            if (Regions.Size > 0 && !HasReadableBytes(page_addr, page_addr + OptPageSize))
+                continue;
+            int idx = FindPageIndex(page_addr);
+            const size_t page_size = (mem_size - page_addr < OptPageSize) ? mem_size - page_addr : OptPageSize;
+            if (idx < Pages.Size && Pages[idx].Addr == page_addr)
+            {
+                // Request again if completion seems lost (SetPageData() accepts any reply while pending)
+                PageEntry& page = Pages[idx];
+                page.LastUsedFrame = frame;
+                if (page.Status == ByteStatus_Pending && OptPagePendingTimeoutFrames > 0 && frame - page.RequestFrame >= OptPagePendingTimeoutFrames)
+                {
+                    page.RequestFrame = frame;
+                    Stats.RequestPageFnCalls++;
+                    RequestPageFn(mem_data, page_addr, page_size, UserData);
+                }
+                continue;
+            }
+
+            // Evict least recently used page (never evict pages used this frame, or pending requests used recently: a late SetPageData() for an evicted page is ignored)
+            if (Pages.Size >= OptPageCacheMaxCount)
+            {
+                int evict_idx = -1;
+                for (int n = 0; n < Pages.Size; n++)
+                    if (Pages[n].LastUsedFrame != frame && (Pages[n].Status != ByteStatus_Pending || (OptPagePendingTimeoutFrames > 0 && frame - Pages[n].LastUsedFrame >= OptPagePendingTimeoutFrames)))
+                        if (evict_idx == -1 || Pages[n].LastUsedFrame < Pages[evict_idx].LastUsedFrame)
+                            evict_idx = n;
+                if (evict_idx == -1)
+                    return;
+                if (Pages[evict_idx].Slot >= 0)
+                    PagesFreeSlots.push_back(Pages[evict_idx].Slot);
+                Pages.erase(Pages.Data + evict_idx);
+                idx = FindPageIndex(page_addr);
+            }
+
+            PageEntry page;
+            page.Addr = page_addr;
+            page.Status = ByteStatus_Pending;
+            page.Slot = -1;
+            page.LastUsedFrame = page.RequestFrame = frame;
+            Pages.insert(Pages.Data + idx, page);
+            Stats.RequestPageFnCalls++;
+            RequestPageFn(mem_data, page_addr, page_size, UserData);
+        }
+    }
+
+    // Search
+    // - Results are accumulated over multiple frames, as DrawContents() calls UpdateSearch(). Scanning is stopped after OptSearchMaxResults.
+    // - Direct memory is scanned in place. When using ReadRangeFn/ReadFn memory is read in chunks. Searching is not supported with RequestPageFn.
+    bool StartSearch(const char* pattern, SearchMode mode, size_t mem_size)
+    {
+        StopSearch();
+        if (RequestPageFn)
+            return false;
+        if (mode == SearchMode_Text)
+        {
+            for (const char* p = pattern; *p; p++)
+            {
+                SearchPattern.push_back((ImU8)*p);
+                SearchMask.push_back(0xFF);
+            }
+        }
+        else
+        {
+            // Parse hexadecimal digits, '?' for wildcard nibbles, spaces are ignored.
+            int nibble_n = 0;
+            for (const char* p = pattern; *p; p++)
+            {
+                const char c = *p;
+                int value = -1;
+                if (c == ' ' || c == '\t')
+                    continue;
+                else if (c >= '0' && c <= '9')
+                    value = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    value = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    value = c - 'A' + 10;
+                else if (c != '?')
+                    break;
+                if ((nibble_n++ & 1) == 0)
+                {
+                    SearchPattern.push_back(0);
+                    SearchMask.push_back(0);
+                }
+                const int shift = (nibble_n & 1) ? 4 : 0;
+                if (value != -1)
+                {
+                    SearchPattern.back() |= (ImU8)(value << shift);
+                    SearchMask.back() |= (ImU8)(0x0F << shift);
+                }
+            }
+            if (nibble_n & 1)
+                SearchPattern.resize(0); // Incomplete byte
+        }
+        if (SearchPattern.Size == 0)
+        {
+            StopSearch();
+            return false;
+        }
+        SearchActive = true;
+        SearchScanAddr = 0;
+        SearchMemSize = mem_size;
+        return true;
+    }
+
+    void StopSearch()
+    {
+        SearchPattern.resize(0);
+        SearchMask.resize(0);
+        SearchResults.resize(0);
+        SearchActive = false;
+    }
+
+    // Scan up to OptSearchBytesPerFrame bytes. Called by DrawContents().
+    void UpdateSearch(const ImU8* mem_data, size_t mem_size)
+    {
+        if (!SearchActive)
+            return;
+        if (mem_size != SearchMemSize)
+        {
+            // Restart when memory size changed
+            SearchResults.resize(0);
+            SearchScanAddr = 0;
+            SearchMemSize = mem_size;
+        }
+
+        const size_t pattern_size = (size_t)SearchPattern.Size;
+        const size_t scan_end = (mem_size >= pattern_size) ? mem_size - pattern_size + 1 : 0; // Last possible start address + 1
+        if (SearchParallelForFn && !ReadFn && !ReadRangeFn && Regions.Size == 0)
+        {
+            // Split into disjoint ranges of start addresses, each job reading up to pattern_size - 1 bytes past its range.
+            // Results of consecutive jobs are sorted relative to each other, so merging is a concatenation.
+            const int jobs_count = (OptSearchJobsCount < 1) ? 1 : (OptSearchJobsCount > SearchJobsMaxCount) ? SearchJobsMaxCount : OptSearchJobsCount;
+            int jobs_used = 0;
+            for (int job_n = 0; job_n < jobs_count && SearchScanAddr < scan_end; job_n++, jobs_used++)
+            {
+                SearchJob& job = SearchJobs[job_n];
+                job.MemData = mem_data;
+                job.ScanAddr = SearchScanAddr;
+                job.ScanCount = (scan_end - SearchScanAddr < OptSearchBytesPerFrame) ? scan_end - SearchScanAddr : OptSearchBytesPerFrame;
+                job.MaxResults = OptSearchMaxResults - SearchResults.Size;
+                job.Results.resize(0);
+                SearchScanAddr += job.ScanCount;
+            }
+            if (jobs_used > 0)
+                SearchParallelForFn(SearchJobFn, this, jobs_used, UserData);
+            for (int job_n = 0; job_n < jobs_used && SearchResults.Size < OptSearchMaxResults; job_n++)
+                for (size_t result_addr : SearchJobs[job_n].Results)
+                    if (SearchResults.Size < OptSearchMaxResults)
+                        SearchResults.push_back(result_addr);
+        }
+        else
+        {
+            const size_t chunk_size = 64 * 1024;
+            size_t budget = OptSearchBytesPerFrame;
+            while (budget > 0 && SearchScanAddr < scan_end && SearchResults.Size < OptSearchMaxResults)
+            {
+                size_t count = (scan_end - SearchScanAddr < budget) ? scan_end - SearchScanAddr : budget;
+                size_t region_end = (size_t)-1;
+                if (Regions.Size > 0)
+                {
+                    // Skip gaps between regions
+                    const size_t readable_addr = GetNextReadableAddr(SearchScanAddr);
+                    if (readable_addr >= scan_end)
+                    {
+                        SearchScanAddr = scan_end;
+                        break;
+                    }
+                    SearchScanAddr = readable_addr;
+                    const Region* region = FindRegion(SearchScanAddr);
+                    region_end = region->Addr + region->Size;
+                    const size_t count_end = (region_end < scan_end) ? region_end : scan_end;
+                    count = (count_end - SearchScanAddr < budget) ? count_end - SearchScanAddr : budget;
+                }
+                if (ReadFn || ReadRangeFn || Regions.Size > 0)
+                {
+                    // Read a chunk, overlapping with next one so matches across chunk boundaries are found
+                    if (count > chunk_size)
+                        count = chunk_size;
+                    SearchChunkBuf.resize((int)(count + pattern_size - 1));
+                    ReadBytesFromSource(mem_data, SearchScanAddr, SearchChunkBuf.Data, (size_t)SearchChunkBuf.Size);
+                    const int results_count = SearchResults.Size;
+                    SearchInBuffer(SearchChunkBuf.Data, count, SearchScanAddr, SearchPattern.Data, SearchMask.Data, pattern_size, &SearchResults, OptSearchMaxResults);
+                    if (Regions.Size > 0)
+                    {
+                        // Bytes past the end of a region are read as zeroes: only keep matches overlapping it if all their bytes are readable
+                        int write_n = results_count;
+                        for (int read_n = results_count; read_n < SearchResults.Size; read_n++)
+                            if (SearchResults[read_n] + pattern_size <= region_end || IsRangeReadable(SearchResults[read_n], SearchResults[read_n] + pattern_size))
+                                SearchResults[write_n++] = SearchResults[read_n];
+                        SearchResults.resize(write_n);
+                    }
+                }
+                else
+                {
+                    SearchInBuffer(mem_data + SearchScanAddr, count, SearchScanAddr, SearchPattern.Data, SearchMask.Data, pattern_size, &SearchResults, OptSearchMaxResults);
+                }
+                SearchScanAddr += count;
+                budget -= count;
+            }
+        }
+        if (SearchScanAddr >= scan_end || SearchResults.Size >= OptSearchMaxResults)
+            SearchActive = false;
+    }
+
+    // [Internal] Called by SearchParallelForFn, possibly from another thread: only reads from MemoryEditor and writes to its own SearchJob.
+    static void SearchJobFn(void* job_data, int job_n)
+    {
+        MemoryEditor* editor = (MemoryEditor*)job_data;
+        SearchJob& job = editor->SearchJobs[job_n];
+        SearchInBuffer(job.MemData + job.ScanAddr, job.ScanCount, job.ScanAddr, editor->SearchPattern.Data, editor->SearchMask.Data, (size_t)editor->SearchPattern.Size, &job.Results, job.MaxResults);
+    }
+
+    // [Internal] Find matches starting in buf[0..count). 'buf' must hold count + pattern_size - 1 bytes. 'pattern' must be pre-masked.
+    static void SearchInBuffer(const ImU8* buf, size_t count, size_t buf_addr, const ImU8* pattern, const ImU8* mask, size_t pattern_size, ImVector<size_t>* out_results, int max_results)
+    {
+        // Use first fully specified byte as an anchor to quickly skip with memchr()
+        size_t anchor_n = 0;
+        while (anchor_n < pattern_size && mask[anchor_n] != 0xFF)
+            anchor_n++;
+
+        const ImU8* p = buf;
+        const ImU8* p_end = buf + count;
+        while (p < p_end)
+        {
+            if (anchor_n < pattern_size)
+            {
+                p = (const ImU8*)memchr(p + anchor_n, pattern[anchor_n], (size_t)(p_end - p)); // Search in [p + anchor_n, p_end + anchor_n)
+                if (p == NULL)
+                    return;
+                p -= anchor_n;
+            }
+            size_t n = 0;
+            while (n < pattern_size && (p[n] & mask[n]) == pattern[n])
+                n++;
+            if (n == pattern_size)
+            {
+                out_results->push_back(buf_addr + (size_t)(p - buf));
+                if (out_results->Size >= max_results)
+                    return;
+            }
+            p++;
+        }
+    }
+
+    // Index of first result >= addr
+    int FindSearchResultIndex(size_t addr) const
+    {
+        int lo = 0, hi = SearchResults.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) >> 1;
+            if (SearchResults.Data[mid] < addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Return address of nearest result after/before 'addr', wrapping around. Return (size_t)-1 if none.
+    size_t FindNextSearchResult(size_t addr, bool backward) const
+    {
+        if (SearchResults.Size == 0)
+            return (size_t)-1;
+        if (backward)
+        {
+            const int idx = FindSearchResultIndex(addr) - 1;
+            return SearchResults[idx >= 0 ? idx : SearchResults.Size - 1];
+        }
+        const int idx = FindSearchResultIndex(addr + 1);
+        return SearchResults[idx < SearchResults.Size ? idx : 0];
+    }
+
+    // Minimap
+    // - Blocks are computed over multiple frames, starting from the top. Blocks written by the editor are computed again.
+    // - Call InvalidateMinimap() when data changed outside of the editor.
+    // - Not computed when using RequestPageFn.
+    void InvalidateMinimap(size_t addr_min = 0, size_t addr_max = (size_t)-1)
+    {
+        if (MinimapBlocks.Size == 0 || addr_min >= addr_max)
+            return;
+        const size_t block_min = addr_min / MinimapBlockSize;
+        const size_t block_max = (addr_max - 1) / MinimapBlockSize;
+        if (block_min >= (size_t)MinimapBlocks.Size)
+            return;
+        for (size_t block_n = block_min; block_n <= block_max && block_n < (size_t)MinimapBlocks.Size; block_n++)
+            MinimapBlocks[(int)block_n].Status = MinimapBlock_Unknown;
+        if (MinimapScanBlock > (int)block_min)
+            MinimapScanBlock = (int)block_min;
+    }
+
+    // [Internal] Compute up to OptMinimapBytesPerFrame bytes of minimap blocks. Called by DrawContents().
+    void UpdateMinimap(const ImU8* mem_data, size_t mem_size)
+    {
+        IM_ASSERT(OptMinimapBlockSize > 0);
+        size_t block_size = OptMinimapBlockSize;
+        if (mem_size / block_size >= MinimapMaxBlocks)
+            block_size = (mem_size / MinimapMaxBlocks / OptMinimapBlockSize + 1) * OptMinimapBlockSize;
+        if (MinimapBlockSize != block_size || MinimapMemSize != mem_size || MinimapBlocks.Size == 0)
+        {
+            MinimapBlockSize = block_size;
+            MinimapMemSize = mem_size;
+            MinimapBlocks.resize((int)((mem_size + block_size - 1) / block_size));
+            memset(MinimapBlocks.Data, 0, (size_t)MinimapBlocks.Size * sizeof(MinimapBlock));
+            MinimapScanBlock = 0;
+        }
+        if (RequestPageFn)
+            return;
+        for (size_t budget = OptMinimapBytesPerFrame; MinimapScanBlock < MinimapBlocks.Size && budget > 0; MinimapScanBlock++)
+        {
+            MinimapBlock& block = MinimapBlocks[MinimapScanBlock];
+            if (block.Status != MinimapBlock_Unknown)
+                continue;
+            const size_t block_addr = (size_t)MinimapScanBlock * block_size;
+            const size_t block_end = (mem_size - block_addr < block_size) ? mem_size : block_addr + block_size;
+            const size_t read_size = ComputeMinimapBlock(mem_data, block_addr, block_end, &block);
+            budget = (budget > read_size) ? budget - read_size : 0;
+        }
+    }
+
+    // [Internal] Summarize readable bytes of [block_addr, block_end). Blocks larger than OptMinimapBlockSize are sampled with evenly spaced chunks.
+    // Return number of bytes read.
+    size_t ComputeMinimapBlock(const ImU8* mem_data, size_t block_addr, size_t block_end, MinimapBlock* out_block)
+    {
+        // Count into 4 interleaved histograms, so consecutive equal bytes don't wait on the same counter
+        ImU32 counts[4][256];
+        memset(counts, 0, sizeof(counts));
+        const size_t chunk_size = 4096;
+        const size_t chunks_count = (OptMinimapBlockSize + chunk_size - 1) / chunk_size;
+        const size_t chunk_stride = (block_end - block_addr > chunks_count * chunk_size) ? (block_end - block_addr) / chunks_count : chunk_size;
+        size_t total = 0;
+        for (size_t chunk_addr = block_addr; chunk_addr < block_end; chunk_addr += chunk_stride)
+        {
+            const size_t chunk_end = (block_end - chunk_addr < chunk_size) ? block_end : chunk_addr + chunk_size;
+            for (size_t addr = chunk_addr, addr_end = chunk_end; addr < chunk_end; addr = addr_end)
+            {
+                if (Regions.Size > 0)
+                {
+                    // Skip gaps between regions
+                    addr = GetNextReadableAddr(addr);
+                    if (addr >= chunk_end)
+                        break;
+                    const Region* region = FindRegion(addr);
+                    addr_end = (region->Addr + region->Size < chunk_end) ? region->Addr + region->Size : chunk_end;
+                }
+                const size_t size = addr_end - addr;
+                const ImU8* data = mem_data + addr;
+                if (ReadFn || ReadRangeFn || Regions.Size > 0)
+                {
+                    MinimapChunkBuf.resize((int)size);
+                    ReadBytesFromSource(mem_data, addr, MinimapChunkBuf.Data, size);
+                    data = MinimapChunkBuf.Data;
+                }
+                size_t n = 0;
+                for (; n + 4 <= size; n += 4)
+                {
+                    counts[0][data[n + 0]]++;
+                    counts[1][data[n + 1]]++;
+                    counts[2][data[n + 2]]++;
+                    counts[3][data[n + 3]]++;
+                }
+                for (; n < size; n++)
+                    counts[0][data[n]]++;
+                total += size;
+            }
+        }
+        if (total == 0)
+        {
+            out_block->Status = MinimapBlock_Unmapped;
+            return chunk_size;
+        }
+
+        // Entropy in bits per byte: log2(total) - sum(count * log2(count)) / total
+        float sum = 0.0f;
+        size_t zero = 0, ascii = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            const size_t count = (size_t)counts[0][b] + counts[1][b] + counts[2][b] + counts[3][b];
+            if (count == 0)
+                continue;
+            sum += (float)count * logf((float)count);
+            if (b == 0)
+                zero = count;
+            else if ((b >= 32 && b < 127) || b == '\t' || b == '\n' || b == '\r')
+                ascii += count;
+        }
+        const float entropy = (logf((float)total) - sum / (float)total) / logf(2.0f);
+        out_block->Status = MinimapBlock_Valid;
+        out_block->Entropy = (ImU8)(entropy <= 0.0f ? 0 : entropy >= 8.0f ? 255 : (int)(entropy * 255.0f / 8.0f + 0.5f));
+        out_block->Zero = (ImU8)(zero * 255 / total);
+        out_block->Ascii = (ImU8)(ascii * 255 / total);
+        return total;
+    }
+
+    // [Internal] Minimap column. Each row of pixels averages the blocks it covers.
+    void DrawMinimap(const Sizes& s, size_t mem_size, size_t base_display_addr, float height)
+    {
+        const ImVec2 pos = ImGui::GetCursorScreenPos();
+        const ImVec2 size(s.MinimapWidth, height);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+        // Jump to clicked address
+        ImGui::InvisibleButton("##minimap", ImVec2(size.x, size.y > 1.0f ? size.y : 1.0f));
+        const float mouse_ratio = (ImGui::GetIO().MousePos.y - pos.y) / size.y;
+        const size_t mouse_addr = (mem_size == 0 || mouse_ratio <= 0.0f) ? 0 : (mouse_ratio >= 1.0f) ? mem_size - 1 : (size_t)((double)mouse_ratio * (double)mem_size);
+        if (ImGui::IsItemActive() && mem_size > 0)
+        {
+            size_t goto_addr = mouse_addr;
+            if (Regions.Size > 0)
+            {
+                // Jump to start of next region when clicking a gap
+                const int region_n = FindRegionIndex(goto_addr);
+                if (region_n < Regions.Size && Regions[region_n].Addr > goto_addr)
+                    goto_addr = Regions[region_n].Addr;
+            }
+            if (goto_addr < mem_size)
+            {
+                GotoAddr = goto_addr;
+                ApplyGotoAddr(mem_size);
+            }
+        }
+        else if (ImGui::IsItemHovered() && MinimapBlocks.Size > 0)
+        {
+            const MinimapBlock& block = MinimapBlocks[(int)(mouse_addr / MinimapBlockSize)];
+            char addr_buf[32];
+            ImSnprintf(addr_buf, IM_ARRAYSIZE(addr_buf), s.FormatData, s.AddrDigitsCount, base_display_addr + mouse_addr);
+            if (block.Status == MinimapBlock_Valid)
+                ImGui::SetTooltip("%s\nEntropy: %.2f bits\nZero: %d%%, Ascii: %d%%", addr_buf, block.Entropy * 8.0f / 255.0f, block.Zero * 100 / 255, block.Ascii * 100 / 255);
+            else
+                ImGui::SetTooltip("%s", addr_buf);
+        }
+
+        const int rows_count = (int)size.y;
+        const int blocks_count = MinimapBlocks.Size;
+        if (blocks_count == 0 || rows_count <= 0)
+            return;
+        for (int row_n = 0; row_n < rows_count; )
+        {
+            // Average valid blocks of this row
+            const int block_min = (int)((ImU64)row_n * blocks_count / rows_count);
+            int block_max = (int)((ImU64)(row_n + 1) * blocks_count / rows_count);
+            if (block_max <= block_min)
+                block_max = block_min + 1;
+            int valid_count = 0, entropy = 0, zero = 0, ascii = 0;
+            for (int block_n = block_min; block_n < block_max; block_n++)
+                if (MinimapBlocks[block_n].Status == MinimapBlock_Valid)
+                {
+                    valid_count++;
+                    entropy += MinimapBlocks[block_n].Entropy;
+                    zero += MinimapBlocks[block_n].Zero;
+                    ascii += MinimapBlocks[block_n].Ascii;
+                }
+
+            // Merge following rows covering the same blocks (when there are less blocks than rows)
+            int row_end = row_n + 1;
+            for (; row_end < rows_count; row_end++)
+            {
+                const int next_block_min = (int)((ImU64)row_end * blocks_count / rows_count);
+                const int next_block_max = (int)((ImU64)(row_end + 1) * blocks_count / rows_count);
+                if (next_block_min != block_min || (next_block_max > next_block_min ? next_block_max : next_block_min + 1) != block_max)
+                    break;
+            }
+            const float y1 = pos.y + row_n;
+            const float y2 = pos.y + row_end;
+            row_n = row_end;
+            if (valid_count == 0)
+                continue;
+            entropy /= valid_count;
+            zero /= valid_count;
+            ascii /= valid_count;
+            if (OptMinimapMode == MinimapMode_Entropy)
+            {
+                const ImU32 color = IM_COL32(20 + entropy * 235 / 255, 40 + entropy * 40 / 255, 120 - entropy * 90 / 255, 255);
+                draw_list->AddRectFilled(ImVec2(pos.x, y1), ImVec2(pos.x + size.x, y2), color);
+            }
+            else
+            {
+                const float x_zero = pos.x + size.x * zero / 255.0f;
+                const float x_ascii = x_zero + size.x * ascii / 255.0f;
+                draw_list->AddRectFilled(ImVec2(pos.x, y1), ImVec2(x_zero, y2), IM_COL32(90, 90, 90, 255));
+                draw_list->AddRectFilled(ImVec2(x_zero, y1), ImVec2(x_ascii, y2), IM_COL32(60, 140, 255, 255));
+                draw_list->AddRectFilled(ImVec2(x_ascii, y1), ImVec2(pos.x + size.x, y2), IM_COL32(255, 130, 40, 255));
+            }
+        }
+
+        // Visible range
+        if (VisibleAddrMin < VisibleAddrMax && mem_size > 0)
+        {
+            const float y1 = pos.y + (float)((double)VisibleAddrMin / (double)mem_size * size.y);
+            float y2 = pos.y + (float)((double)VisibleAddrMax / (double)mem_size * size.y);
+            if (y2 < y1 + 2.0f)
+                y2 = y1 + 2.0f;
+            draw_list->AddRect(ImVec2(pos.x, y1), ImVec2(pos.x + size.x, y2), ImGui::GetColorU32(ImGuiCol_Text));
+        }
+    }
+
+    // Display modes
+    // - DisplayMode_Words draws one cell per PreviewDataType value. Trailing bytes of a line which don't fill a value are displayed as "--", use a multiple of the value size for Cols.
+    // - DisplayMode_Pixels draws one cell per byte or 4 bytes word, adjacent cells of same color are merged into a single rectangle. Hover cells for address and value.
+    // - In both modes clicking a cell sets the data preview address. Use DisplayMode_Hex to edit.
+    int GetWordCharsCount(ImGuiDataType data_type) const
+    {
+        static const int chars_counts[] = { 4, 3, 6, 5, 11, 10, 20, 20, 12, 12 }; // "-128", "255", ... "-1.17549e-38"
+        IM_ASSERT(data_type >= 0 && data_type < IM_ARRAYSIZE(chars_counts));
+        return chars_counts[data_type];
+    }
+
+    int GetPixelFormatSize(int pixel_format) const { return (pixel_format == PixelFormat_RGBA32) ? 4 : 1; }
+
+    // [Internal] Integers are formatted as in data preview, floats with "%g" to fit in a cell.
+    void FormatWordData(const ImU8* src, size_t size, ImGuiDataType data_type, char* out_buf, size_t out_buf_size) const
+    {
+        ImU8 buf[8];
+        memcpy(buf, src, size);
+        if (data_type == ImGuiDataType_Float)
+        {
+            float data = 0.0f;
+            EndiannessCopy(&data, buf, size);
+            ImSnprintf(out_buf, out_buf_size, "%g", data);
+        }
+        else if (data_type == ImGuiDataType_Double)
+        {
+            double data = 0.0;
+            EndiannessCopy(&data, buf, size);
+            ImSnprintf(out_buf, out_buf_size, "%g", data);
+        }
+        else
+        {
+            FormatPreviewData(src, size, data_type, DataFormat_Dec, out_buf, out_buf_size);
+        }
+    }
+
+    // [Internal] DisplayMode_Words: right-aligned values, with a single hit test per line
+    void DrawWordsLine(const Sizes& s, const ImU8* mem_data, size_t line_addr, int line_cols, const ImVec2& line_origin, bool is_window_hovered)
+    {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImU32 color_text = ImGui::GetColorU32(ImGuiCol_Text);
+        const ImU32 color_text_disabled = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        const int word_size = (int)DataTypeGetSize(PreviewDataType);
+        const int word_chars = GetWordCharsCount(PreviewDataType);
+        for (int n = 0; n < line_cols; n += word_size)
+        {
+            const size_t addr = line_addr + n;
+            char buf[32] = "--";
+            ImU32 color = color_text_disabled;
+            if (n + word_size <= line_cols)
+            {
+                int status = ByteStatus_Ok;
+                for (int byte_n = 0; byte_n < word_size && status == ByteStatus_Ok; byte_n++)
+                    status = GetByteStatus(addr + byte_n);
+                if (status != ByteStatus_Ok)
+                {
+                    ImSnprintf(buf, IM_ARRAYSIZE(buf), (status == ByteStatus_Pending) ? ".." : "??");
+                }
+                else
+                {
+                    ImU8 raw[8];
+                    ReadBytes(mem_data, addr, raw, (size_t)word_size);
+                    FormatWordData(raw, (size_t)word_size, PreviewDataType, buf, IM_ARRAYSIZE(buf));
+                    bool is_zero = true;
+                    for (int byte_n = 0; byte_n < word_size; byte_n++)
+                        is_zero &= (raw[byte_n] == 0);
+                    color = (is_zero && OptGreyOutZeroes) ? color_text_disabled : color_text;
+                }
+            }
+            int len = (int)strlen(buf);
+            if (len > word_chars)
+                len = word_chars;
+            draw_list->AddText(ImVec2(line_origin.x + GetHexCellPosX(s, n) + (word_chars - len) * s.GlyphWidth, line_origin.y), color, buf, buf + len);
+        }
+
+        if (is_window_hovered)
+        {
+            const ImVec2 mouse_pos = ImGui::GetIO().MousePos;
+            const float mouse_off_x = mouse_pos.x - (line_origin.x + s.PosHexStart);
+            if (mouse_pos.y >= line_origin.y && mouse_pos.y < line_origin.y + s.LineHeight && mouse_off_x >= 0.0f && mouse_off_x < s.PosHexEnd - s.PosHexStart)
+            {
+                const int n = GetHexCellFromOffsetX(s, mouse_off_x);
+                if (n < line_cols)
+                {
+                    MouseHovered = true;
+                    MouseHoveredAddr = line_addr + n - n % word_size;
+                    if (ImGui::IsMouseClicked(0))
+                    {
+                        DataPreviewAddr = MouseHoveredAddr;
+                        DataEditingAddr = (size_t)-1;
+                    }
+                }
+            }
+        }
+    }
+
+    // [Internal] DisplayMode_Pixels: cells are drawn first, then background colors (selection, highlights...) on top.
+    void DrawPixelsLine(const Sizes& s, const ImU8* mem_data, size_t mem_size, size_t base_display_addr, size_t line_addr, int line_cols, const ImVec2& line_origin, const ImU32* bg_colors, bool is_window_hovered)
+    {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const int pixel_size = GetPixelFormatSize(OptPixelFormat);
+        const int pixels_count = (line_cols + pixel_size - 1) / pixel_size;
+        const float x0 = line_origin.x + s.PosHexStart;
+        const float y1 = line_origin.y;
+        const float y2 = line_origin.y + s.LineHeight;
+        LinePixelColors.resize(pixels_count);
+        for (int pixel_n = 0; pixel_n < pixels_count; pixel_n++)
+        {
+            const size_t addr = line_addr + (size_t)pixel_n * pixel_size;
+            const int bytes_count = (line_cols - pixel_n * pixel_size < pixel_size) ? line_cols - pixel_n * pixel_size : pixel_size;
+            ImU8 raw[4] = { 0, 0, 0, 0 };
+            ImU32 color = 0;
+            int status = ByteStatus_Ok;
+            for (int byte_n = 0; byte_n < bytes_count && status == ByteStatus_Ok; byte_n++)
+                status = GetByteStatus(addr + byte_n);
+            if (status == ByteStatus_Ok)
+            {
+                ReadBytes(mem_data, addr, raw, (size_t)bytes_count);
+                const ImU8 b = raw[0];
+                if (OptPixelFormat == PixelFormat_Gray8)
+                    color = IM_COL32(b, b, b, 255);
+                else if (OptPixelFormat == PixelFormat_Classes8)
+                    color = (b == 0) ? IM_COL32(90, 90, 90, 255) : ((b >= 32 && b < 127) || b == '\t' || b == '\n' || b == '\r') ? IM_COL32(60, 140, 255, 255) : IM_COL32(255, 130, 40, 255);
+                else
+                    color = IM_COL32(raw[0], raw[1], raw[2], 255);
+            }
+            LinePixelColors.Data[pixel_n] = color;
+        }
+        const float pixel_width = s.HexCellWidth * pixel_size;
+        for (int n = 0, n_end = 0; n < pixels_count; n = n_end)
+        {
+            const ImU32 color = LinePixelColors.Data[n];
+            for (n_end = n + 1; n_end < pixels_count && LinePixelColors.Data[n_end] == color; n_end++) {}
+            if (color != 0)
+                draw_list->AddRectFilled(ImVec2(x0 + n * pixel_width, y1), ImVec2(x0 + n_end * pixel_width, y2), color);
+        }
+        for (int n = 0, n_end = 0; n < line_cols; n = n_end)
+        {
+            const ImU32 bg_color = bg_colors[n];
+            for (n_end = n + 1; n_end < line_cols && bg_colors[n_end] == bg_color; n_end++) {}
+            if (bg_color != 0)
+                draw_list->AddRectFilled(ImVec2(x0 + n * s.HexCellWidth, y1), ImVec2(x0 + n_end * s.HexCellWidth, y2), bg_color);
+        }
+
+        if (is_window_hovered)
+        {
+            const ImVec2 mouse_pos = ImGui::GetIO().MousePos;
+            const float mouse_off_x = mouse_pos.x - x0;
+            if (mouse_pos.y >= y1 && mouse_pos.y < y2 && mouse_off_x >= 0.0f && mouse_off_x < pixels_count * pixel_width)
+            {
+                const int pixel_n = (int)(mouse_off_x / pixel_width);
+                const size_t addr = line_addr + (size_t)pixel_n * pixel_size;
+                MouseHovered = true;
+                MouseHoveredAddr = addr;
+                if (ImGui::IsMouseClicked(0))
+                {
+                    DataPreviewAddr = addr;
+                    DataEditingAddr = (size_t)-1;
+                }
+                char buf[32] = "";
+                if (GetByteStatus(addr) == ByteStatus_Ok)
+                    for (size_t byte_n = 0; byte_n < (size_t)pixel_size && addr + byte_n < mem_size; byte_n++)
+                        ImSnprintf(buf + byte_n * 3, 4, s.FormatByteSpace, ReadByte(mem_data, addr + byte_n));
+                ImGui::SetTooltip(OptUpperCaseHex ? "%0*" _PRISizeT "X: %s" : "%0*" _PRISizeT "x: %s", s.AddrDigitsCount, base_display_addr + addr, buf);
+            }
+        }
+    }
+
+    // Struct overlays
+    // - Fields are copied, their Name pointers are stored. Fields may overlap (e.g. unions).
+    // - Values are decoded with data preview endianness. Decoded text is cached for each field and only formatted again when its bytes change.
+    int AddStructOverlay(const char* name, size_t addr, const StructField* fields, int fields_count)
+    {
+        StructOverlay overlay;
+        overlay.Name = name;
+        overlay.Addr = addr;
+        overlay.FieldsIndex = StructFields.Size;
+        overlay.FieldsCount = fields_count;
+        StructOverlays.push_back(overlay);
+        for (int n = 0; n < fields_count; n++)
+        {
+            StructFields.push_back(fields[n]);
+            StructFieldSpan span;
+            memset(&span, 0, sizeof(span));
+            span.Addr = addr + fields[n].Offset;
+            span.FieldIndex = overlay.FieldsIndex + n;
+            span.OverlayIndex = StructOverlays.Size - 1;
+            const int span_n = FindStructSpanIndex(span.Addr + 1); // Keep insertion order for fields at same address
+            StructSpans.insert(StructSpans.Data + span_n, span);
+        }
+        return StructOverlays.Size - 1;
+    }
+    void ClearStructOverlays()  { StructOverlays.clear(); StructFields.clear(); StructSpans.clear(); StructVisibleSpans.clear(); }
+
+    // [Internal] Index of first span with Addr >= addr
+    int FindStructSpanIndex(size_t addr) const
+    {
+        int lo = 0, hi = StructSpans.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (StructSpans[mid].Addr < addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    size_t GetStructSpanSize(const StructFieldSpan& span) const { return DataTypeGetSize(StructFields[span.FieldIndex].DataType); }
+
+    // [Internal] Return index of first span covering 'addr', or -1. 'span_n' is advanced past spans ending before 'addr', so consecutive calls must use increasing addresses.
+    int FindStructSpanAt(int* span_n, size_t addr) const
+    {
+        while (*span_n < StructSpans.Size && StructSpans[*span_n].Addr + GetStructSpanSize(StructSpans[*span_n]) <= addr)
+            (*span_n)++;
+        for (int n = *span_n; n < StructSpans.Size && StructSpans[n].Addr <= addr; n++)
+            if (addr < StructSpans[n].Addr + GetStructSpanSize(StructSpans[n]))
+                return n;
+        return -1;
+    }
+
+    // [Internal] Background color of struct field covering 'addr', or 0.
+    ImU32 GetStructFieldColor(int* span_n, size_t addr) const
+    {
+        const int n = FindStructSpanAt(span_n, addr);
+        if (n < 0)
+            return 0;
+        const StructFieldSpan& span = StructSpans[n];
+        const StructField& field = StructFields[span.FieldIndex];
+        if (field.Color != 0)
+            return field.Color;
+        if ((span.FieldIndex - StructOverlays[span.OverlayIndex].FieldsIndex) & 1)
+            return (StructFieldColor & ~IM_COL32_A_MASK) | ((((StructFieldColor >> IM_COL32_A_SHIFT) & 0xFF) / 2) << IM_COL32_A_SHIFT);
+        return StructFieldColor;
+    }
+
+    // [Internal] Return cached decoded value of a field, decoding it only if its bytes changed. Return NULL if bytes are not available.
+    const char* GetStructFieldValue(const ImU8* mem_data, size_t mem_size, StructFieldSpan& span)
+    {
+        const size_t size = GetStructSpanSize(span);
+        if (span.Addr >= mem_size || size > mem_size - span.Addr)
+            return NULL;
+        for (size_t n = 0; n < size; n++)
+            if (GetByteStatus(span.Addr + n) != ByteStatus_Ok)
+                return NULL;
+        ImU8 raw[8];
+        ReadBytes(mem_data, span.Addr, raw, size);
+        if (!span.Decoded || span.DecodedEndianness != PreviewEndianness || memcmp(raw, span.Raw, size) != 0)
+        {
+            memcpy(span.Raw, raw, size);
+            FormatPreviewData(raw, size, StructFields[span.FieldIndex].DataType, DataFormat_Dec, span.Value, IM_ARRAYSIZE(span.Value));
+            span.Decoded = true;
+            span.DecodedEndianness = PreviewEndianness;
+        }
+        return span.Value;
+    }
+
+    // [Internal] Tooltip listing fields covering hovered address
+    void DrawStructFieldTooltip(const Sizes& s, const ImU8* mem_data, size_t mem_size, size_t base_display_addr, size_t addr)
+    {
+        int span_n = FindStructSpanIndex(addr >= 7 ? addr - 7 : 0);
+        if (FindStructSpanAt(&span_n, addr) < 0)
+            return;
+        if (!ImGui::BeginTooltip())
+            return;
+        for (int n = span_n; n < StructSpans.Size && StructSpans[n].Addr <= addr; n++)
+            if (addr < StructSpans[n].Addr + GetStructSpanSize(StructSpans[n]))
+                DrawStructFieldText(s, mem_data, mem_size, base_display_addr, StructSpans[n]);
+        ImGui::EndTooltip();
+    }
+
+    // [Internal] "ADDR  Overlay.Field  Type  Value"
+    void DrawStructFieldText(const Sizes& s, const ImU8* mem_data, size_t mem_size, size_t base_display_addr, StructFieldSpan& span)
+    {
+        const StructField& field = StructFields[span.FieldIndex];
+        const char* value = GetStructFieldValue(mem_data, mem_size, span);
+        const float start_x = ImGui::GetCursorPosX();
+        ImGui::Text(OptUpperCaseHex ? "%0*" _PRISizeT "X:" : "%0*" _PRISizeT "x:", s.AddrDigitsCount, base_display_addr + span.Addr);
+        ImGui::SameLine();
+        ImGui::Text("%s.%s", StructOverlays[span.OverlayIndex].Name, field.Name);
+        ImGui::SameLine(start_x + s.GlyphWidth * (s.AddrDigitsCount + 32));
+        ImGui::TextDisabled("%s", DataTypeGetDesc(field.DataType));
+        ImGui::SameLine(start_x + s.GlyphWidth * (s.AddrDigitsCount + 40));
+        ImGui::TextUnformatted(value ? value : "N/A");
+    }
 
-        char buf[128] = "";
-        float x = s.GlyphWidth * 6.0f;
-        bool has_value = DataPreviewAddr != (size_t)-1;
-        if (has_value)
-            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Dec, buf, (size_t)IM_ARRAYSIZE(buf));
-        ImGui::Text("Dec"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
-        if (has_value)
-            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Hex, buf, (size_t)IM_ARRAYSIZE(buf));
-        ImGui::Text("Hex"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
-        if (has_value)
-            DrawPreviewData(DataPreviewAddr, mem_data, mem_size, PreviewDataType, DataFormat_Bin, buf, (size_t)IM_ARRAYSIZE(buf));
-        buf[IM_ARRAYSIZE(buf) - 1] = 0;
-        ImGui::Text("Bin"); ImGui::SameLine(x); ImGui::TextUnformatted(has_value ? buf : "N/A");
+    // [Internal] List fields intersecting the visible range
+    void DrawStructsPanel(const Sizes& s, const ImU8* mem_data, size_t mem_size, size_t base_display_addr)
+    {
+        StructVisibleSpans.resize(0);
+        if (VisibleAddrMin < VisibleAddrMax)
+            for (int n = FindStructSpanIndex(VisibleAddrMin >= 7 ? VisibleAddrMin - 7 : 0); n < StructSpans.Size && StructSpans[n].Addr < VisibleAddrMax; n++)
+                if (StructSpans[n].Addr + GetStructSpanSize(StructSpans[n]) > VisibleAddrMin)
+                    StructVisibleSpans.push_back(n);
+
+        ImGui::BeginChild("##structs", ImVec2(-FLT_MIN, ImGui::GetTextLineHeightWithSpacing() * OptStructsPanelLines), ImGuiChildFlags_None, ImGuiWindowFlags_NoMove);
+        if (StructVisibleSpans.Size == 0)
+            ImGui::TextDisabled(StructSpans.Size ? "No struct fields in visible range." : "No struct overlays. Use AddStructOverlay().");
+        ImGuiListClipper clipper;
+        clipper.Begin(StructVisibleSpans.Size);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                DrawStructFieldText(s, mem_data, mem_size, base_display_addr, StructSpans[StructVisibleSpans[n]]);
+        ImGui::EndChild();
+    }
+
+    // Watches
+    // - UpdateWatches() reads all watched values once per frame and compares them with the previous values. DrawContents() calls it,
+    //   call it yourself every frame when the editor may not be drawn (e.g. collapsed window) or before DrawContents() to get changes earlier.
+    // - Watches closer than OptWatchesMergeGap are read with a single ReadRangeFn/ReadFn call. With RequestPageFn their pages are requested, and values are compared once available.
+    // - WatchChangedFn is called for each changed value (not on first read). Don't add or remove watches from within it.
+    int AddWatch(const char* name, size_t addr, ImGuiDataType data_type)
+    {
+        Watch watch;
+        memset(&watch, 0, sizeof(watch));
+        watch.ID = ++WatchesNextID;
+        watch.Name = name;
+        watch.Addr = addr;
+        watch.DataType = data_type;
+        watch.ChangedFrame = -1;
+        watch.ChangedTime = -1.0;
+        const int watch_n = FindWatchIndex(addr + 1); // Keep insertion order for watches at same address
+        Watches.insert(Watches.Data + watch_n, watch);
+        return watch.ID;
+    }
+    bool RemoveWatch(int id)
+    {
+        for (int n = 0; n < Watches.Size; n++)
+            if (Watches[n].ID == id)
+            {
+                Watches.erase(Watches.Data + n);
+                return true;
+            }
+        return false;
+    }
+    const Watch* FindWatch(int id) const
+    {
+        for (const Watch& watch : Watches)
+            if (watch.ID == id)
+                return &watch;
+        return NULL;
+    }
+    void ClearWatches() { Watches.clear(); }
+
+    void UpdateWatches(const void* mem_data_void, size_t mem_size)
+    {
+        const int frame = ImGui::GetFrameCount();
+        if (WatchesUpdateFrame == frame)
+            return;
+        WatchesUpdateFrame = frame;
+        const ImU8* mem_data = (const ImU8*)mem_data_void;
+        for (int watch_n = 0, watch_end = 0; watch_n < Watches.Size; watch_n = watch_end)
+        {
+            // Gather following watches into a single read
+            const size_t read_min = Watches[watch_n].Addr;
+            size_t read_max = read_min + GetWatchSize(Watches[watch_n]);
+            for (watch_end = watch_n + 1; watch_end < Watches.Size && Watches[watch_end].Addr < read_max + OptWatchesMergeGap; watch_end++)
+                if (read_max < Watches[watch_end].Addr + GetWatchSize(Watches[watch_end]))
+                    read_max = Watches[watch_end].Addr + GetWatchSize(Watches[watch_end]);
+            if (read_min >= mem_size)
+                break;
+            if (read_max > mem_size)
+                read_max = mem_size;
+
+            const size_t read_size = read_max - read_min;
+            WatchesReadBuf.resize((int)read_size);
+            WatchesReadStatus.resize((int)read_size);
+            if (RequestPageFn)
+            {
+                RequestPages(mem_data, mem_size, read_min, read_max);
+                ReadBytesFromPages(read_min, WatchesReadBuf.Data, read_size, WatchesReadStatus.Data);
+            }
+            else
+            {
+                ReadBytesFromSource(mem_data, read_min, WatchesReadBuf.Data, read_size);
+                memset(WatchesReadStatus.Data, ByteStatus_Ok, read_size);
+            }
+            for (int n = watch_n; n < watch_end; n++)
+                UpdateWatch(mem_data, Watches[n], read_min, read_max);
+        }
+    }
+
+    // [Internal] Compare value of a watch with bytes of WatchesReadBuf, read from [read_min, read_max)
+    void UpdateWatch(const ImU8* mem_data, Watch& watch, size_t read_min, size_t read_max)
+    {
+        const size_t size = GetWatchSize(watch);
+        if (watch.Addr >= read_max || size > read_max - watch.Addr)
+            return;
+        const size_t read_off = watch.Addr - read_min;
+        for (size_t n = 0; n < size; n++)
+            if (WatchesReadStatus[(int)(read_off + n)] != ByteStatus_Ok || (Regions.Size > 0 && !IsAddrReadable(watch.Addr + n)))
+                return;
+        const ImU8* value = WatchesReadBuf.Data + read_off;
+        if (!watch.Valid)
+        {
+            memcpy(watch.Value, value, size);
+            watch.Valid = true;
+            return;
+        }
+        if (memcmp(watch.Value, value, size) == 0)
+            return;
+        ImU8 old_value[8];
+        memcpy(old_value, watch.Value, size);
+        memcpy(watch.Value, value, size);
+        watch.ChangesCount++;
+        watch.ChangedFrame = ImGui::GetFrameCount();
+        watch.ChangedTime = ImGui::GetTime();
+        if (WatchChangedFn)
+            WatchChangedFn(mem_data, watch, old_value, UserData);
+    }
+
+    // [Internal] Index of first watch with Addr >= addr
+    int FindWatchIndex(size_t addr) const
+    {
+        int lo = 0, hi = Watches.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (Watches[mid].Addr < addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    size_t GetWatchSize(const Watch& watch) const { return DataTypeGetSize(watch.DataType); }
+
+    // [Internal] Background color of watch covering 'addr', or 0. 'watch_n' is advanced past watches ending before 'addr', so consecutive calls must use increasing addresses.
+    ImU32 GetWatchColor(int* watch_n, size_t addr) const
+    {
+        while (*watch_n < Watches.Size && Watches[*watch_n].Addr + GetWatchSize(Watches[*watch_n]) <= addr)
+            (*watch_n)++;
+        for (int n = *watch_n; n < Watches.Size && Watches[n].Addr <= addr; n++)
+        {
+            const Watch& watch = Watches[n];
+            if (addr >= watch.Addr + GetWatchSize(watch))
+                continue;
+            const float changed_elapsed = (float)(ImGui::GetTime() - watch.ChangedTime);
+            if (watch.ChangedFrame < 0 || OptChangesFadeTime <= 0.0f || changed_elapsed >= OptChangesFadeTime)
+                return WatchColor;
+            const int heat = (int)(255.0f * (1.0f - changed_elapsed / OptChangesFadeTime));
+            return (ChangedColor & ~IM_COL32_A_MASK) | ((((ChangedColor >> IM_COL32_A_SHIFT) & 0xFF) * heat / 255) << IM_COL32_A_SHIFT);
+        }
+        return 0;
+    }
+
+    // [Internal] List all watches. Click on an address to go to it.
+    void DrawWatchesPanel(const Sizes& s, size_t base_display_addr)
+    {
+        ImGui::BeginChild("##watches", ImVec2(-FLT_MIN, ImGui::GetTextLineHeightWithSpacing() * OptWatchesPanelLines), ImGuiChildFlags_None, ImGuiWindowFlags_NoMove);
+        if (Watches.Size == 0)
+            ImGui::TextDisabled("No watches. Use AddWatch().");
+        ImGuiListClipper clipper;
+        clipper.Begin(Watches.Size);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                const Watch& watch = Watches[n];
+                const float start_x = ImGui::GetCursorPosX();
+                char buf[64];
+                ImSnprintf(buf, IM_ARRAYSIZE(buf), OptUpperCaseHex ? "%0*" _PRISizeT "X:" : "%0*" _PRISizeT "x:", s.AddrDigitsCount, base_display_addr + watch.Addr);
+                ImGui::PushID(watch.ID);
+                if (ImGui::Selectable(buf, false, ImGuiSelectableFlags_None, ImVec2(s.GlyphWidth * (s.AddrDigitsCount + 1), 0.0f)))
+                    GotoAddrAndHighlight(watch.Addr, watch.Addr + GetWatchSize(watch));
+                ImGui::PopID();
+                ImGui::SameLine();
+                ImGui::TextUnformatted(watch.Name ? watch.Name : "-");
+                ImGui::SameLine(start_x + s.GlyphWidth * (s.AddrDigitsCount + 32));
+                ImGui::TextDisabled("%s", DataTypeGetDesc(watch.DataType));
+                ImGui::SameLine(start_x + s.GlyphWidth * (s.AddrDigitsCount + 40));
+                if (watch.Valid)
+                    FormatPreviewData(watch.Value, GetWatchSize(watch), watch.DataType, DataFormat_Dec, buf, IM_ARRAYSIZE(buf));
+                ImGui::TextUnformatted(watch.Valid ? buf : "N/A");
+                ImGui::SameLine(start_x + s.GlyphWidth * (s.AddrDigitsCount + 64));
+                ImGui::TextDisabled("%d changes", watch.ChangesCount);
+            }
+        ImGui::EndChild();
+    }
+
+    // Regions
+    // - Only bytes inside regions are displayed and read. Regions must be sorted by address and not overlapping.
+    // - Gaps between regions are displayed as a single line.
+    void SetRegions(const Region* regions, int regions_count)
+    {
+        Regions.resize(0);
+        for (int n = 0; n < regions_count; n++)
+        {
+            IM_ASSERT((n == 0 || regions[n - 1].Addr + regions[n - 1].Size <= regions[n].Addr) && "Regions must be sorted and non-overlapping!");
+            if (regions[n].Size > 0)
+                Regions.push_back(regions[n]);
+        }
+        RegionsLines.resize(0);
+        RegionLinesCols = 0;
+        MinimapBlocks.resize(0);
+    }
+    void ClearRegions() { SetRegions(NULL, 0); }
+
+    // [Internal] Index of first region ending after 'addr'
+    int FindRegionIndex(size_t addr) const
+    {
+        int lo = 0, hi = Regions.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (Regions[mid].Addr + Regions[mid].Size <= addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    const Region* FindRegion(size_t addr) const
+    {
+        const int region_n = FindRegionIndex(addr);
+        return (region_n < Regions.Size && Regions[region_n].Addr <= addr) ? &Regions[region_n] : NULL;
+    }
+
+    bool IsAddrReadable(size_t addr) const
+    {
+        if (Regions.Size == 0)
+            return true;
+        const Region* region = FindRegion(addr);
+        return region && !(region->Flags & RegionFlags_Unreadable);
+    }
+
+    bool IsAddrWritable(size_t addr) const
+    {
+        if (Regions.Size == 0)
+            return true;
+        const Region* region = FindRegion(addr);
+        return region && !(region->Flags & (RegionFlags_Unreadable | RegionFlags_ReadOnly));
+    }
+
+    // [Internal] Return first readable address >= addr, or (size_t)-1 if none
+    size_t GetNextReadableAddr(size_t addr) const
+    {
+        for (int region_n = FindRegionIndex(addr); region_n < Regions.Size; region_n++)
+            if (!(Regions[region_n].Flags & RegionFlags_Unreadable))
+                return (Regions[region_n].Addr > addr) ? Regions[region_n].Addr : addr;
+        return (size_t)-1;
+    }
+
+    // [Internal] Return true if all bytes in [addr_min, addr_max) are in readable regions
+    bool IsRangeReadable(size_t addr_min, size_t addr_max) const
+    {
+        if (Regions.Size == 0)
+            return true;
+        size_t addr = addr_min;
+        for (int region_n = FindRegionIndex(addr_min); region_n < Regions.Size && addr < addr_max; region_n++)
+        {
+            const Region& region = Regions[region_n];
+            if (region.Addr > addr || (region.Flags & RegionFlags_Unreadable))
+                return false;
+            addr = region.Addr + region.Size;
+        }
+        return addr >= addr_max;
+    }
+
+    // [Internal] Return true if any byte in [addr_min, addr_max) is readable
+    bool HasReadableBytes(size_t addr_min, size_t addr_max) const
+    {
+        for (int region_n = FindRegionIndex(addr_min); region_n < Regions.Size && Regions[region_n].Addr < addr_max; region_n++)
+            if (!(Regions[region_n].Flags & RegionFlags_Unreadable))
+                return true;
+        return false;
+    }
+
+    // [Internal] Build displayed lines of regions, clipped to mem_size.
+    void BuildRegionLines(size_t mem_size)
+    {
+        RegionsLines.resize(0);
+        RegionLinesCols = Cols;
+        RegionLinesMemSize = mem_size;
+        size_t lines_count = 0;
+        for (const Region& region : Regions)
+        {
+            if (region.Addr >= mem_size)
+                break;
+            const size_t region_end = (mem_size - region.Addr > region.Size) ? region.Addr + region.Size : mem_size;
+            const size_t addr_line_min = region.Addr / Cols;
+            const size_t addr_line_max = (region_end + Cols - 1) / Cols;
+            if (RegionsLines.Size > 0 && RegionsLines.back().AddrLineMax >= addr_line_min)
+            {
+                // Shares or touches last line of previous region: merge
+                lines_count += addr_line_max - RegionsLines.back().AddrLineMax;
+                RegionsLines.back().AddrLineMax = addr_line_max;
+                continue;
+            }
+            if (RegionsLines.Size > 0)
+                lines_count++; // Gap line
+            RegionLines region_lines;
+            region_lines.AddrLineMin = addr_line_min;
+            region_lines.AddrLineMax = addr_line_max;
+            region_lines.LineMin = lines_count;
+            RegionsLines.push_back(region_lines);
+            lines_count += addr_line_max - addr_line_min;
+        }
+    }
+
+    // Number of displayed lines
+    size_t GetLinesCount(size_t mem_size) const
+    {
+        if (Regions.Size == 0)
+            return (mem_size + Cols - 1) / Cols;
+        if (RegionsLines.Size == 0)
+            return 0;
+        const RegionLines& last = RegionsLines.back();
+        return last.LineMin + (last.AddrLineMax - last.AddrLineMin);
+    }
+
+    // [Internal] Index of first RegionLines ending after displayed line 'line'
+    int FindRegionLinesIndex(size_t line) const
+    {
+        int lo = 0, hi = RegionsLines.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (RegionsLines[mid].LineMin + (RegionsLines[mid].AddrLineMax - RegionsLines[mid].AddrLineMin) <= line)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Return first address of displayed line, or (size_t)-1 for a gap line. 'out_line_end' receives the end of the run of lines with contiguous addresses.
+    size_t GetAddrFromLine(size_t line, size_t* out_line_end) const
+    {
+        if (Regions.Size == 0)
+        {
+            *out_line_end = (size_t)-1;
+            return line * Cols;
+        }
+        const int region_lines_n = FindRegionLinesIndex(line);
+        if (region_lines_n >= RegionsLines.Size || line < RegionsLines[region_lines_n].LineMin)
+        {
+            *out_line_end = line + 1;
+            return (size_t)-1;
+        }
+        const RegionLines& region_lines = RegionsLines[region_lines_n];
+        *out_line_end = region_lines.LineMin + (region_lines.AddrLineMax - region_lines.AddrLineMin);
+        return (region_lines.AddrLineMin + (line - region_lines.LineMin)) * Cols;
+    }
+
+    // Return displayed line of 'addr'. Addresses in gaps between regions return the gap line.
+    size_t GetLineFromAddr(size_t addr) const
+    {
+        if (Regions.Size == 0)
+            return addr / Cols;
+        const size_t addr_line = addr / Cols;
+        int lo = 0, hi = RegionsLines.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (RegionsLines[mid].AddrLineMax <= addr_line)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo >= RegionsLines.Size)
+            return GetLinesCount(RegionLinesMemSize) > 0 ? GetLinesCount(RegionLinesMemSize) - 1 : 0;
+        const RegionLines& region_lines = RegionsLines[lo];
+        if (addr_line < region_lines.AddrLineMin)
+            return (region_lines.LineMin > 0) ? region_lines.LineMin - 1 : 0;
+        return region_lines.LineMin + (addr_line - region_lines.AddrLineMin);
+    }
+
+    // [Internal] Draw collapsed gap between regions
+    void DrawRegionGapLine(const Sizes& s, size_t line, size_t base_display_addr)
+    {
+        const int region_lines_n = FindRegionLinesIndex(line);
+        IM_ASSERT(region_lines_n > 0 && region_lines_n < RegionsLines.Size);
+        const size_t gap_min = RegionsLines[region_lines_n - 1].AddrLineMax * Cols;
+        const size_t gap_max = RegionsLines[region_lines_n].AddrLineMin * Cols;
+        if (OptDisplayMode == DisplayMode_Pixels)
+        {
+            // No room for text
+            const ImVec2 pos = ImGui::GetCursorScreenPos();
+            ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(pos.x, pos.y + s.LineHeight * 0.25f), ImVec2(pos.x + s.PosHexEnd, pos.y + s.LineHeight * 0.75f), ImGui::GetColorU32(ImGuiCol_TextDisabled));
+            ImGui::Dummy(ImVec2(s.PosHexEnd, s.LineHeight));
+            return;
+        }
+        const char* format_gap = OptUpperCaseHex ? "-- %0*" _PRISizeT "X..%0*" _PRISizeT "X not mapped --" : "-- %0*" _PRISizeT "x..%0*" _PRISizeT "x not mapped --";
+        ImGui::TextDisabled(format_gap, s.AddrDigitsCount, base_display_addr + gap_min, s.AddrDigitsCount, base_display_addr + gap_max - 1);
+    }
+
+    // Compare view
+    // - Compare data is displayed as a read-only hexadecimal column next to the main data and must be directly accessible (ReadFn etc. only apply to main data).
+    // - Block differences are not computed when using RequestPageFn: FindNextDiff() then only compares bytes currently in cache.
+    void SetCompareData(const void* mem_data, size_t mem_size)
+    {
+        if ((CompareMemData != NULL) != (mem_data != NULL))
+            ContentsWidthChanged = true;
+        CompareMemData = (const ImU8*)mem_data;
+        CompareMemSize = mem_data ? mem_size : 0;
+        RefreshCompareBlocks();
+    }
+    void ClearCompareData()     { SetCompareData(NULL, 0); }
+    void RefreshCompareBlocks() { CompareBlocks.resize(0); CompareScanBlock = 0; } // Call when data changed outside of the editor.
+
+    // [Internal] Mark blocks of [addr_min, addr_max) to be compared again. Called after the editor wrote to them.
+    void InvalidateCompareBlocks(size_t addr_min, size_t addr_max)
+    {
+        if (CompareBlocks.Size == 0 || addr_min >= addr_max)
+            return;
+        const size_t block_min = addr_min / OptCompareBlockSize;
+        const size_t block_max = (addr_max - 1) / OptCompareBlockSize;
+        if (block_min >= (size_t)CompareBlocks.Size)
+            return;
+        for (size_t block_n = block_min; block_n <= block_max && block_n < (size_t)CompareBlocks.Size; block_n++)
+            CompareBlocks[(int)block_n] = CompareBlock_Unknown;
+        if (CompareScanBlock > (int)block_min)
+            CompareScanBlock = (int)block_min;
+    }
+
+    // [Internal] Compare up to OptCompareBytesPerFrame bytes. Called by DrawContents().
+    void UpdateCompareBlocks(const ImU8* mem_data, size_t mem_size)
+    {
+        IM_ASSERT(OptCompareBlockSize > 0);
+        const size_t total_size = (mem_size > CompareMemSize) ? mem_size : CompareMemSize;
+        const int blocks_count = (int)((total_size + OptCompareBlockSize - 1) / OptCompareBlockSize);
+        if (CompareBlocks.Size != blocks_count)
+        {
+            CompareBlocks.resize(blocks_count);
+            memset(CompareBlocks.Data, CompareBlock_Unknown, (size_t)blocks_count);
+            CompareScanBlock = 0;
+        }
+        if (RequestPageFn)
+            return;
+        for (size_t budget = OptCompareBytesPerFrame; CompareScanBlock < blocks_count && budget > 0; CompareScanBlock++)
+        {
+            if (CompareBlocks[CompareScanBlock] == CompareBlock_Unknown && Regions.Size > 0 && !HasReadableBytes((size_t)CompareScanBlock * OptCompareBlockSize, (size_t)(CompareScanBlock + 1) * OptCompareBlockSize))
+                CompareBlocks[CompareScanBlock] = CompareBlock_Equal; // Not mapped
+            if (CompareBlocks[CompareScanBlock] == CompareBlock_Unknown)
+                CompareBlocks[CompareScanBlock] = CompareBlock(mem_data, mem_size, (size_t)CompareScanBlock * OptCompareBlockSize, false) ? CompareBlock_Different : CompareBlock_Equal;
+            budget = (budget > OptCompareBlockSize) ? budget - OptCompareBlockSize : 0;
+        }
+    }
+
+    // [Internal] Compare bytes in block starting at 'block_addr'. Return true if any differ, and optionally the address of the first/last difference.
+    bool CompareBlock(const ImU8* mem_data, size_t mem_size, size_t block_addr, bool backward, size_t* out_diff_addr = NULL)
+    {
+        const size_t block_end = block_addr + OptCompareBlockSize;
+        const size_t common_end = (mem_size < CompareMemSize) ? mem_size : CompareMemSize;
+        const size_t size = (block_addr >= common_end) ? 0 : (block_end < common_end) ? OptCompareBlockSize : common_end - block_addr;
+        const ImU8* data = mem_data + block_addr;
+        if (ReadFn || ReadRangeFn || RequestPageFn || Regions.Size > 0)
+        {
+            CompareChunkBuf.resize((int)size);
+            ReadBytesFromSource(mem_data, block_addr, CompareChunkBuf.Data, size);
+            data = CompareChunkBuf.Data;
+        }
+        const ImU8* compare_data = CompareMemData + block_addr;
+        const bool has_tail = (mem_size != CompareMemSize && block_end > common_end); // Bytes existing on one side only are different
+        if (out_diff_addr == NULL)
+            return has_tail || memcmp(data, compare_data, size) != 0;
+
+        size_t diff_addr = (size_t)-1;
+        if (!backward)
+        {
+            for (size_t n = 0; n < size && diff_addr == (size_t)-1; n++)
+                if (data[n] != compare_data[n])
+                    diff_addr = block_addr + n;
+            if (diff_addr == (size_t)-1 && has_tail)
+                diff_addr = block_addr + size;
+        }
+        else
+        {
+            const size_t total_size = (mem_size > CompareMemSize) ? mem_size : CompareMemSize;
+            if (has_tail)
+                diff_addr = ((block_end < total_size) ? block_end : total_size) - 1;
+            for (size_t n = size; n > 0 && diff_addr == (size_t)-1; n--)
+                if (data[n - 1] != compare_data[n - 1])
+                    diff_addr = block_addr + n - 1;
+        }
+        *out_diff_addr = diff_addr;
+        return diff_addr != (size_t)-1;
+    }
+
+    // Return address of nearest difference after/before 'addr', or (size_t)-1 if none. Identical blocks are skipped using the block scan results.
+    size_t FindNextDiff(const ImU8* mem_data, size_t mem_size, size_t addr, bool backward)
+    {
+        if (CompareMemData == NULL || CompareBlocks.Size == 0)
+            return (size_t)-1;
+        const size_t block_size = OptCompareBlockSize;
+        const size_t total_size = (mem_size > CompareMemSize) ? mem_size : CompareMemSize;
+        for (int block_n = (int)(addr / block_size); block_n >= 0 && block_n < CompareBlocks.Size; block_n += backward ? -1 : +1)
+        {
+            if (CompareBlocks[block_n] == CompareBlock_Equal)
+                continue;
+            const size_t block_addr = (size_t)block_n * block_size;
+            size_t diff_addr;
+            if (!CompareBlock(mem_data, mem_size, block_addr, backward, &diff_addr))
+            {
+                CompareBlocks[block_n] = CompareBlock_Equal;
+                continue;
+            }
+            if (!backward && diff_addr <= addr)
+            {
+                // Diff in the starting block is before 'addr': scan forward from it
+                diff_addr = (size_t)-1;
+                for (size_t scan_addr = addr + 1; scan_addr < block_addr + block_size && scan_addr < total_size && diff_addr == (size_t)-1; scan_addr++)
+                    if (scan_addr >= mem_size || scan_addr >= CompareMemSize || ReadByte(mem_data, scan_addr) != CompareMemData[scan_addr])
+                        diff_addr = scan_addr;
+            }
+            else if (backward && diff_addr >= addr)
+            {
+                diff_addr = (size_t)-1;
+                for (size_t scan_addr = addr; scan_addr > block_addr && diff_addr == (size_t)-1; scan_addr--)
+                    if (scan_addr - 1 >= mem_size || scan_addr - 1 >= CompareMemSize || ReadByte(mem_data, scan_addr - 1) != CompareMemData[scan_addr - 1])
+                        diff_addr = scan_addr - 1;
+            }
+            if (diff_addr != (size_t)-1)
+                return diff_addr;
+        }
+        return (size_t)-1;
+    }
+
+    // Changes tracking
+    // - Tracked range follows visible lines (from previous frame) + OptChangesPrefetchLines above and below, so cost doesn't depend on mem_size.
+    // - When pinned, bytes are compared to their value at the time they were first tracked after pinning, instead of previous frame.
+    //   Those values are kept in blocks of ChangesPinBlockSize bytes when scrolled out of view, up to OptChangesPinMaxSize bytes.
+    void PinChangesSnapshot()   { ChangesPinned = true; }
+    void UnpinChangesSnapshot() { ChangesPinned = false; ChangesShadow.resize(0); ChangesHeat.resize(0); ChangesPinBlocks.clear(); ChangesPinData.clear(); }
+
+    // [Internal] Called by DrawContents() when OptShowChanges is set.
+    void UpdateChanges(const ImU8* mem_data, size_t mem_size)
+    {
+        // Calculate tracked range. When pinned, it is aligned to pinned blocks so they are always fully tracked.
+        const size_t prefetch_size = (size_t)OptChangesPrefetchLines * Cols;
+        size_t addr_min = (VisibleAddrMin > prefetch_size) ? VisibleAddrMin - prefetch_size : 0;
+        size_t addr_max = (mem_size - VisibleAddrMax > prefetch_size) ? VisibleAddrMax + prefetch_size : mem_size;
+        if (Regions.Size > 0 && addr_max - addr_min > prefetch_size * 2 + ChangesMaxVisibleLines * Cols)
+            addr_max = addr_min + prefetch_size * 2 + ChangesMaxVisibleLines * Cols; // Visible range may span a large gap between regions
+        if (ChangesPinned)
+        {
+            const size_t addr_max_rem = addr_max % ChangesPinBlockSize;
+            addr_min -= addr_min % ChangesPinBlockSize;
+            if (addr_max_rem != 0)
+                addr_max = (mem_size - addr_max > ChangesPinBlockSize - addr_max_rem) ? addr_max + ChangesPinBlockSize - addr_max_rem : mem_size;
+        }
+        if (addr_min >= addr_max)
+            addr_min = addr_max = 0;
+        const int size = (int)(addr_max - addr_min);
+
+        // Read current values
+        ImVector<ImU8>& current = ChangesScratch;
+        current.resize(size * 2);
+        ImU8* current_status = current.Data + size;
+        if (RequestPageFn)
+            ReadBytesFromPages(addr_min, current.Data, (size_t)size, current_status);
+        else
+            ReadBytesFromSource(mem_data, addr_min, current.Data, (size_t)size);
+
+        // Move previous values of tracked range in place. Newly tracked bytes use their current value, or their pinned value.
+        if (addr_min != ChangesAddr || size != ChangesShadow.Size)
+        {
+            const size_t overlap_min = (addr_min > ChangesAddr) ? addr_min : ChangesAddr;
+            const size_t overlap_max = (addr_max < ChangesAddr + ChangesShadow.Size) ? addr_max : ChangesAddr + ChangesShadow.Size;
+            const size_t overlap_size = (overlap_min < overlap_max) ? overlap_max - overlap_min : 0;
+            const size_t dst_offset = overlap_size ? overlap_min - addr_min : 0;
+            if (overlap_size > 0)
+            {
+                const size_t src_offset = overlap_min - ChangesAddr;
+                if (size > ChangesShadow.Size)
+                {
+                    ChangesShadow.resize(size);
+                    ChangesHeat.resize(size);
+                }
+                memmove(ChangesShadow.Data + dst_offset, ChangesShadow.Data + src_offset, overlap_size);
+                memmove(ChangesHeat.Data + dst_offset, ChangesHeat.Data + src_offset, overlap_size);
+            }
+            ChangesShadow.resize(size);
+            ChangesHeat.resize(size);
+            const size_t tail_offset = dst_offset + overlap_size;
+            memcpy(ChangesShadow.Data, current.Data, dst_offset);
+            memset(ChangesHeat.Data, 0, dst_offset);
+            memcpy(ChangesShadow.Data + tail_offset, current.Data + tail_offset, (size_t)size - tail_offset);
+            memset(ChangesHeat.Data + tail_offset, 0, (size_t)size - tail_offset);
+            ChangesAddr = addr_min;
+            if (ChangesPinned)
+                UpdateChangesPinBlocks();
+        }
+
+        // Bytes not currently readable are considered unchanged
+        if (RequestPageFn)
+            for (int n = 0; n < size; n++)
+                if (current_status[n] != ByteStatus_Ok)
+                    current.Data[n] = ChangesShadow.Data[n];
+
+        // Fade out
+        ChangesFadeAccum += (OptChangesFadeTime > 0.0f) ? ImGui::GetIO().DeltaTime * 255.0f / OptChangesFadeTime : 255.0f;
+        const int fade = (int)ChangesFadeAccum;
+        ChangesFadeAccum -= (float)fade;
+        if (fade > 0 && !ChangesPinned)
+            for (ImU8& heat : ChangesHeat)
+                heat = (heat > fade) ? (ImU8)(heat - fade) : 0;
+
+        // Compare
+        if (ChangesPinned)
+        {
+            for (int n = 0; n < size; n++)
+                ChangesHeat.Data[n] = (current.Data[n] != ChangesShadow.Data[n]) ? 255 : 0;
+        }
+        else
+        {
+            CompareAndMarkChanges(ChangesShadow.Data, current.Data, ChangesHeat.Data, (size_t)size);
+            memcpy(ChangesShadow.Data, current.Data, (size_t)size);
+        }
+    }
+
+    // [Internal] After tracked range moved while pinned: restore pinned values of blocks tracked before, snapshot new blocks.
+    // Shadow values of a pinned range are never updated, so blocks are created from them.
+    void UpdateChangesPinBlocks()
+    {
+        const size_t addr_max = ChangesAddr + ChangesShadow.Size;
+        int block_n = FindChangesPinBlockIndex(ChangesAddr);
+        for (size_t block_addr = ChangesAddr; block_addr < addr_max; block_addr += ChangesPinBlockSize)
+        {
+            const int block_size = (addr_max - block_addr < ChangesPinBlockSize) ? (int)(addr_max - block_addr) : ChangesPinBlockSize;
+            ImU8* shadow = ChangesShadow.Data + (block_addr - ChangesAddr);
+            if (block_n < ChangesPinBlocks.Size && ChangesPinBlocks[block_n].Addr == block_addr)
+            {
+                const ChangesPinBlock& block = ChangesPinBlocks[block_n++];
+                memcpy(shadow, ChangesPinData.Data + block.DataOffset, (size_t)(block.Size < block_size ? block.Size : block_size));
+                continue;
+            }
+            if ((size_t)ChangesPinData.Size + block_size > OptChangesPinMaxSize)
+                continue;
+            ChangesPinBlock block;
+            block.Addr = block_addr;
+            block.Size = block_size;
+            block.DataOffset = ChangesPinData.Size;
+            ChangesPinData.resize(ChangesPinData.Size + block_size);
+            memcpy(ChangesPinData.Data + block.DataOffset, shadow, (size_t)block_size);
+            ChangesPinBlocks.insert(ChangesPinBlocks.Data + block_n++, block);
+        }
+    }
+
+    // [Internal] Index of first pinned block with Addr >= addr
+    int FindChangesPinBlockIndex(size_t addr) const
+    {
+        int lo = 0, hi = ChangesPinBlocks.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (ChangesPinBlocks[mid].Addr < addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // [Internal] Set heat[n] = 255 where a[n] != b[n]. Equal bytes are skipped 8 at a time.
+    static void CompareAndMarkChanges(const ImU8* a, const ImU8* b, ImU8* heat, size_t size)
+    {
+        size_t n = 0;
+        for (; n + 8 <= size; n += 8)
+        {
+            ImU64 a8, b8;
+            memcpy(&a8, a + n, 8);
+            memcpy(&b8, b + n, 8);
+            if (a8 == b8)
+                continue;
+            for (size_t i = n; i < n + 8; i++)
+                if (a[i] != b[i])
+                    heat[i] = 255;
+        }
+        for (; n < size; n++)
+            if (a[n] != b[n])
+                heat[n] = 255;
+    }
+
+    // [Internal] Two hexadecimal digits for each byte value
+    static const char* GetHexLut(bool upper_case)
+    {
+        static char lut[2][256 * 2];
+        static bool lut_initialized = false;
+        if (!lut_initialized)
+        {
+            for (int b = 0; b < 256; b++)
+            {
+                lut[0][b * 2 + 0] = "0123456789abcdef"[b >> 4];
+                lut[0][b * 2 + 1] = "0123456789abcdef"[b & 0x0F];
+                lut[1][b * 2 + 0] = "0123456789ABCDEF"[b >> 4];
+                lut[1][b * 2 + 1] = "0123456789ABCDEF"[b & 0x0F];
+            }
+            lut_initialized = true;
+        }
+        return lut[upper_case ? 1 : 0];
     }
 
     // Utilities for Data Preview (since we don't access imgui_internal.h)
@@ -714,11 +4026,15 @@ struct MemoryEditor
         uint8_t buf[8];
         size_t elem_size = DataTypeGetSize(data_type);
         size_t size = addr + elem_size > mem_size ? mem_size - addr : elem_size;
-        if (ReadFn)
-            for (int i = 0, n = (int)size; i < n; ++i)
-                buf[i] = ReadFn(mem_data, addr + i, UserData);
-        else
-            memcpy(buf, mem_data + addr, size);
+        ReadBytes(mem_data, addr, buf, size);
+        FormatPreviewData(buf, size, data_type, data_format, out_buf, out_buf_size);
+    }
+
+    // [Internal] Format 'size' bytes copied from memory, using PreviewEndianness. 'size' may be smaller than data type size at end of memory.
+    void FormatPreviewData(const ImU8* src, size_t size, ImGuiDataType data_type, DataFormat data_format, char* out_buf, size_t out_buf_size) const
+    {
+        uint8_t buf[8];
+        memcpy(buf, src, size);
 
         if (data_format == DataFormat_Bin)
         {
@@ -0,0 +1,437 @@
+// File data source for Mini memory editor for Dear ImGui
+// Get latest version at http://www.github.com/ocornut/imgui_club
+// Licensed under The MIT License (MIT)
+
+// Display files which are too large to be loaded or mapped as a whole (e.g. multi-GB crash dumps).
+// - The file is mapped read-only through a few windows of OptWindowSize bytes, remapped as the visible range moves.
+//   When mapping a new window for the visible range, it is placed ahead of the scrolling direction of the editor passed to Bind().
+// - Edits are stored in an overlay of sorted runs and never touch the file. Use GetEditsCount()/GetEditedSize()/DiscardEdits(), or iterate Edits[] to save them.
+// - Uses mmap() on POSIX systems and MapViewOfFile() on Windows. On 32-bit POSIX systems, define _FILE_OFFSET_BITS=64 to open files larger than 2 GB.
+// - Editor addresses are relative to a 64-bit view base (default 0). On 32-bit builds, GetSize() is clamped to 4 GB: use SetViewBase() to browse past it.
+//   Displayed addresses are then relative to the view base, unless you pass GetViewBase() as 'base_display_addr' (64-bit builds only).
+//   Changing the view base resets address-dependent state of the bound editor (undo journal, selection, search results...), watches and struct overlays must be added again.
+//
+// Usage:
+//   static MemoryEditor mem_edit;
+//   static MemoryEditorFile mem_file;
+//   if (!mem_file.IsOpen())
+//       if (mem_file.Open("crash.dmp"))
+//           mem_file.Bind(&mem_edit);  // Set ReadRangeFn, WriteRangeFn and UserData
+//   mem_edit.DrawWindow("Memory Editor", NULL, mem_file.GetSize());
+//
+// Changelog:
+// - v0.10 (2026/10/14): initial version.
+
+#pragma once
+
+#include "imgui_memory_editor.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close, sysconf
+#endif
+
+struct MemoryEditorFile
+{
+    // Settings
+    size_t          OptWindowSize;                              // = 64 MB  // size of each mapped window. rounded up to system allocation granularity.
+    bool            ReadOnly;                                   // = false  // disable edits.
+
+    // Mapped windows
+    enum { WindowsMaxCount = 4 };                               // visible range, search and compare scans may each use their own window
+    struct Window
+    {
+        ImU64           Offset;                                 // file offset of first mapped byte (multiple of allocation granularity)
+        size_t          Size;
+        ImU8*           Data;                                   // NULL if not mapped
+        int             LastUsedFrame;
+    };
+    Window          Windows[WindowsMaxCount];
+
+    // Edits overlay: sorted runs of edited bytes. Runs never overlap or touch (adjacent writes are merged into one run).
+    struct EditRun
+    {
+        ImU64           Addr;                                   // file offset (independent of view base)
+        size_t          Size;
+        size_t          Capacity;                               // allocated size of Data, grown when a write extends the run
+        ImU8*           Data;
+    };
+    ImVector<EditRun> Edits;
+
+    // [Internal State]
+    ImU64           FileSize;
+    ImU64           ViewBase;                                   // file offset of editor address 0
+    size_t          Granularity;
+    MemoryEditor*   Editor;                                     // editor passed to last Bind() call. its visible range gives the scrolling direction
+    size_t          LastVisibleAddrMin;
+    bool            ScrollBackward;
+    int             RemapCount;                                 // number of windows mapped since Open(), for statistics
+#ifdef _WIN32
+    HANDLE          FileHandle;
+    HANDLE          MappingHandle;
+#else
+    int             FileDesc;
+#endif
+
+    MemoryEditorFile()
+    {
+        OptWindowSize = 64 * 1024 * 1024;
+        ReadOnly = false;
+        memset(Windows, 0, sizeof(Windows));
+        FileSize = 0;
+        ViewBase = 0;
+        Granularity = 0;
+        Editor = NULL;
+        LastVisibleAddrMin = 0;
+        ScrollBackward = false;
+        RemapCount = 0;
+#ifdef _WIN32
+        FileHandle = INVALID_HANDLE_VALUE;
+        MappingHandle = NULL;
+#else
+        FileDesc = -1;
+#endif
+    }
+    ~MemoryEditorFile() { Close(); }
+
+    bool Open(const char* filename)
+    {
+        Close();
+#ifdef _WIN32
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        Granularity = system_info.dwAllocationGranularity;
+        FileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (FileHandle == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(FileHandle, &file_size) || file_size.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+        FileSize = (ImU64)file_size.QuadPart;
+        MappingHandle = CreateFileMappingA(FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (MappingHandle == NULL)
+        {
+            Close();
+            return false;
+        }
+#else
+        Granularity = (size_t)sysconf(_SC_PAGESIZE);
+        FileDesc = open(filename, O_RDONLY);
+        if (FileDesc < 0)
+            return false;
+        struct stat file_stat;
+        if (fstat(FileDesc, &file_stat) != 0 || file_stat.st_size <= 0)
+        {
+            Close();
+            return false;
+        }
+        FileSize = (ImU64)file_stat.st_size;
+#endif
+        return true;
+    }
+
+    void Close()
+    {
+        for (Window& window : Windows)
+            UnmapWindow(window);
+#ifdef _WIN32
+        if (MappingHandle != NULL)
+            CloseHandle(MappingHandle);
+        if (FileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(FileHandle);
+        MappingHandle = NULL;
+        FileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (FileDesc >= 0)
+            close(FileDesc);
+        FileDesc = -1;
+#endif
+        FileSize = 0;
+        ViewBase = 0;
+        LastVisibleAddrMin = 0;
+        ScrollBackward = false;
+        DiscardEdits();
+    }
+
+    bool IsOpen() const         { return FileSize > 0; }
+
+    // Size to pass to MemoryEditor::DrawWindow()/DrawContents(): from view base to end of file, clamped to addressable range on 32-bit builds.
+    size_t GetSize() const
+    {
+        if (ViewBase >= FileSize)
+            return 0;
+        const ImU64 size = FileSize - ViewBase;
+        return (size > (ImU64)(size_t)-1) ? (size_t)-1 : (size_t)size;
+    }
+
+    // Set file offset of editor address 0. Mapped windows and edits are kept, as they use file offsets.
+    // Editor addresses now designate other bytes: state of the editor passed to Bind() which depends on them is reset (an undo would otherwise write old values at the wrong offset).
+    // Watches and struct overlays are set by you with editor addresses: remove and add them again if needed.
+    ImU64 GetViewBase() const   { return ViewBase; }
+    void  SetViewBase(ImU64 base)
+    {
+        if (base >= FileSize)
+            base = 0;
+        if (base == ViewBase)
+            return;
+        ViewBase = base;
+        LastVisibleAddrMin = 0;
+        ScrollBackward = false;
+        if (Editor != NULL)
+        {
+            const bool changes_pinned = Editor->ChangesPinned;
+            Editor->ClearUndo();
+            Editor->ClearSelection();
+            Editor->StopSearch();
+            Editor->RefreshCompareBlocks();
+            Editor->UnpinChangesSnapshot(); // Also clears changes buffers
+            if (changes_pinned)
+                Editor->PinChangesSnapshot();
+            Editor->InvalidateMinimap();
+            Editor->ReadBuf.resize(0);
+            Editor->ReadBufStatus.resize(0);
+            Editor->DataEditingAddr = Editor->DataPreviewAddr = (size_t)-1;
+            Editor->HighlightMin = Editor->HighlightMax = (size_t)-1;
+        }
+    }
+
+    // Route reads and writes of 'editor' to this file. Pass NULL as mem_data and GetSize() as mem_size when drawing.
+    void Bind(MemoryEditor* editor)
+    {
+        editor->ReadFn = NULL;
+        editor->ReadRangeFn = ReadRangeHandler;
+        editor->WriteFn = NULL;
+        editor->WriteRangeFn = ReadOnly ? NULL : WriteRangeHandler;
+        editor->UserData = this;
+        Editor = editor;
+        if (ReadOnly)
+            editor->ReadOnly = true;
+    }
+
+    // Read bytes, including edits
+    void Read(size_t addr, ImU8* out_buf, size_t size)
+    {
+        if (addr >= GetSize())
+        {
+            memset(out_buf, 0, size);
+            return;
+        }
+        if (size > GetSize() - addr)
+        {
+            memset(out_buf + (GetSize() - addr), 0, size - (GetSize() - addr));
+            size = GetSize() - addr;
+        }
+        // Only reads of the visible range follow the scrolling direction: search/compare scans and other reads always map forward
+        UpdateScrollDirection();
+        const bool scroll_backward = ScrollBackward && Editor != NULL && addr < Editor->VisibleAddrMax && addr + size > Editor->VisibleAddrMin;
+        const ImU64 file_addr = ViewBase + addr;
+        for (size_t done = 0; done < size; )
+        {
+            const ImU64 chunk_addr = file_addr + done;
+            const Window* window = FindOrMapWindow(chunk_addr, scroll_backward);
+            if (window == NULL)
+            {
+                memset(out_buf + done, 0, size - done);
+                break;
+            }
+            const ImU64 window_end = window->Offset + window->Size;
+            const size_t chunk_size = (window_end - chunk_addr < size - done) ? (size_t)(window_end - chunk_addr) : size - done;
+            memcpy(out_buf + done, window->Data + (size_t)(chunk_addr - window->Offset), chunk_size);
+            done += chunk_size;
+        }
+
+        // Apply edits overlay
+        const ImU64 file_addr_end = file_addr + size;
+        for (int run_n = FindEditRunIndex(file_addr); run_n < Edits.Size && Edits[run_n].Addr < file_addr_end; run_n++)
+        {
+            const EditRun& run = Edits[run_n];
+            const ImU64 copy_min = (run.Addr > file_addr) ? run.Addr : file_addr;
+            const ImU64 copy_max = (run.Addr + run.Size < file_addr_end) ? run.Addr + run.Size : file_addr_end;
+            if (copy_min < copy_max)
+                memcpy(out_buf + (size_t)(copy_min - file_addr), run.Data + (size_t)(copy_min - run.Addr), (size_t)(copy_max - copy_min));
+        }
+    }
+
+    void Write(size_t addr, ImU8 value)
+    {
+        Write(addr, &value, 1);
+    }
+
+    void Write(size_t addr, const ImU8* buf, size_t size)
+    {
+        if (ReadOnly || addr >= GetSize() || size == 0)
+            return;
+        if (size > GetSize() - addr)
+            size = GetSize() - addr;
+        const ImU64 file_addr = ViewBase + addr;
+        const ImU64 file_addr_end = file_addr + size;
+
+        // Runs overlapping or touching [addr, addr_end) are merged into the first one
+        const int run_min = FindEditRunIndex(file_addr);
+        int run_max = run_min;
+        while (run_max < Edits.Size && Edits[run_max].Addr <= file_addr_end)
+            run_max++;
+        if (run_min == run_max)
+        {
+            EditRun new_run;
+            new_run.Addr = file_addr;
+            new_run.Size = new_run.Capacity = size;
+            new_run.Data = (ImU8*)IM_ALLOC(size);
+            memcpy(new_run.Data, buf, size);
+            Edits.insert(Edits.Data + run_min, new_run);
+            return;
+        }
+
+        EditRun& run = Edits[run_min];
+        const EditRun& last_run = Edits[run_max - 1];
+        const ImU64 merged_addr = (run.Addr < file_addr) ? run.Addr : file_addr;
+        const ImU64 merged_end = (last_run.Addr + last_run.Size > file_addr_end) ? last_run.Addr + last_run.Size : file_addr_end;
+        const size_t merged_size = (size_t)(merged_end - merged_addr);  // fits: all bytes of merged runs are in memory
+        if (merged_size > run.Capacity)
+        {
+            // Grow geometrically so that typing or pasting next to a run doesn't reallocate it every time
+            const size_t capacity = (merged_size > run.Capacity * 2) ? merged_size : run.Capacity * 2;
+            ImU8* data = (ImU8*)IM_ALLOC(capacity);
+            memcpy(data + (size_t)(run.Addr - merged_addr), run.Data, run.Size);
+            IM_FREE(run.Data);
+            run.Data = data;
+            run.Capacity = capacity;
+        }
+        else if (merged_addr < run.Addr)
+        {
+            memmove(run.Data + (size_t)(run.Addr - merged_addr), run.Data, run.Size);
+        }
+        for (int run_n = run_min + 1; run_n < run_max; run_n++)
+        {
+            memcpy(run.Data + (size_t)(Edits[run_n].Addr - merged_addr), Edits[run_n].Data, Edits[run_n].Size);
+            IM_FREE(Edits[run_n].Data);
+        }
+        memcpy(run.Data + (size_t)(file_addr - merged_addr), buf, size);
+        run.Addr = merged_addr;
+        run.Size = merged_size;
+        if (run_max > run_min + 1)
+            Edits.erase(Edits.Data + run_min + 1, Edits.Data + run_max);
+    }
+
+    int  GetEditsCount() const  { return Edits.Size; }        // number of runs
+    size_t GetEditedSize() const
+    {
+        size_t size = 0;
+        for (const EditRun& run : Edits)
+            size += run.Size;
+        return size;
+    }
+    void DiscardEdits()
+    {
+        for (EditRun& run : Edits)
+            IM_FREE(run.Data);
+        Edits.clear();
+    }
+
+    // [Internal] Update scrolling direction when the visible range of the bound editor moved.
+    // DrawContents() sets VisibleAddrMin before reading visible bytes, and VisibleAddrMin >= VisibleAddrMax while it is being reset.
+    void UpdateScrollDirection()
+    {
+        if (Editor == NULL || Editor->VisibleAddrMin >= Editor->VisibleAddrMax || Editor->VisibleAddrMin == LastVisibleAddrMin)
+            return;
+        ScrollBackward = (Editor->VisibleAddrMin < LastVisibleAddrMin);
+        LastVisibleAddrMin = Editor->VisibleAddrMin;
+    }
+
+    // [Internal] Index of first run ending at or after file offset 'addr' (i.e. overlapping or touching addr)
+    int FindEditRunIndex(ImU64 addr) const
+    {
+        int lo = 0, hi = Edits.Size;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (Edits[mid].Addr + Edits[mid].Size < addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // [Internal] Return a window containing file offset 'addr', mapping one if needed (replacing least recently used window).
+    const Window* FindOrMapWindow(ImU64 addr, bool scroll_backward)
+    {
+        const int frame = ImGui::GetFrameCount();
+        for (Window& window : Windows)
+            if (window.Data != NULL && addr >= window.Offset && addr < window.Offset + window.Size)
+            {
+                window.LastUsedFrame = frame;
+                return &window;
+            }
+
+        Window* window = &Windows[0];
+        for (Window& candidate : Windows)
+            if (candidate.Data == NULL || (window->Data != NULL && candidate.LastUsedFrame < window->LastUsedFrame))
+                window = &candidate;
+        UnmapWindow(*window);
+
+        // Keep a margin behind the requested address and prefetch ahead of the scrolling direction
+        const size_t window_size = ((OptWindowSize > Granularity ? OptWindowSize : Granularity) + Granularity - 1) / Granularity * Granularity;
+        const size_t margin = window_size / 8;
+        ImU64 offset;
+        if (!scroll_backward)
+            offset = (addr > margin) ? addr - margin : 0;
+        else
+            offset = (addr + margin + 1 > window_size) ? addr + margin + 1 - window_size : 0;
+        offset -= offset % Granularity;
+        if (offset + window_size <= addr)
+            offset = addr - addr % Granularity;
+        const size_t size = (FileSize - offset < window_size) ? (size_t)(FileSize - offset) : window_size;
+
+#ifdef _WIN32
+        void* data = MapViewOfFile(MappingHandle, FILE_MAP_READ, (DWORD)(offset >> 32), (DWORD)(offset & 0xFFFFFFFF), size);
+        if (data == NULL)
+            return NULL;
+#else
+        void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, FileDesc, (off_t)offset);
+        if (data == MAP_FAILED)
+            return NULL;
+#endif
+        window->Offset = offset;
+        window->Size = size;
+        window->Data = (ImU8*)data;
+        window->LastUsedFrame = frame;
+        RemapCount++;
+        return window;
+    }
+
+    void UnmapWindow(Window& window)
+    {
+        if (window.Data == NULL)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(window.Data);
+#else
+        munmap(window.Data, window.Size);
+#endif
+        window.Data = NULL;
+        window.Size = 0;
+    }
+
+    static void ReadRangeHandler(const ImU8* mem, size_t off, ImU8* out_buf, size_t size, void* user_data)
+    {
+        IM_UNUSED(mem);
+        ((MemoryEditorFile*)user_data)->Read(off, out_buf, size);
+    }
+
+    static void WriteRangeHandler(ImU8* mem, size_t off, const ImU8* buf, size_t size, void* user_data)
+    {
+        IM_UNUSED(mem);
+        ((MemoryEditorFile*)user_data)->Write(off, buf, size);
+    }
+};
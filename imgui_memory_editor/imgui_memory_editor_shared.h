@@ -0,0 +1,334 @@
+// Shared data source for multiple Mini memory editors for Dear ImGui
+// Get latest version at http://www.github.com/ocornut/imgui_club
+// Licensed under The MIT License (MIT)
+
+// Display many views of the same target (e.g. stack, heap, registers, buffers of a debugged process) without reading the same bytes once per view.
+// - Editors attached with Attach() read through a cache of OptPageSize pages. Each page is read once per frame (or once every OptMaxAgeFrames frames).
+// - NewFrame() merges visible ranges of all attached editors (from their previous DrawContents() call) and reads missing pages of each merged span with a single ReadFn call.
+//   Drawing the editors afterwards only copies from the cache, so read cost scales with unique bytes visible, not with editors count.
+// - Large reads (search, compare, minimap scans) bypass the cache so they don't evict visible pages.
+// - Writes go through WriteFn and update cached pages.
+// - ReadFn may be called on whole pages: up to OptPageSize - 1 bytes before and after a visible range. Fill unreadable bytes with zeros.
+//
+// Usage:
+//   static MemoryEditorShared mem_shared;
+//   mem_shared.ReadFn = MyReadProcessMemory;      // void MyReadProcessMemory(size_t addr, ImU8* out_buf, size_t size, void* user_data)
+//   mem_shared.Attach(&mem_edit_stack);           // Set ReadRangeFn, WriteRangeFn and UserData
+//   mem_shared.Attach(&mem_edit_heap);
+//   ...
+//   mem_shared.NewFrame();                        // Once per frame, before drawing editors
+//   mem_edit_stack.DrawWindow("Stack", NULL, mem_size);
+//   mem_edit_heap.DrawWindow("Heap", NULL, mem_size);
+//
+// Changelog:
+// - v0.10 (2026/10/14): initial version.
+
+#pragma once
+
+#include "imgui_memory_editor.h"
+
+struct MemoryEditorShared
+{
+    // Settings
+    size_t          OptPageSize;                                // = 4096   // cache granularity. power of two.
+    int             OptCachePagesCount;                         // = 1024   // number of cached pages (4 MB with 4 KB pages). power of two.
+    int             OptMaxAgeFrames;                            // = 0      // pages read more than OptMaxAgeFrames frames ago are read again. 0: read every frame (live memory).
+    size_t          OptBypassSize;                              // = 64 KB  // reads larger than this bypass the cache.
+
+    // Data source
+    void            (*ReadFn)(size_t addr, ImU8* out_buf, size_t size, void* user_data);        // = 0  // read a range of bytes from target.
+    void            (*WriteFn)(size_t addr, const ImU8* buf, size_t size, void* user_data);     // = 0  // optional: write a range of bytes to target. attached editors are read-only when NULL.
+    void*           UserData;                                                                   // = NULL
+
+    // Attached editors
+    ImVector<MemoryEditor*> Editors;
+    ImVector<bool>          EditorsPrevReadOnly;            // ReadOnly value of each editor before Attach(), restored by Detach()
+
+    // Statistics, for current frame (reset by NewFrame())
+    int             ReadFnCalls;
+    size_t          ReadFnBytes;
+    size_t          RequestedBytes;                             // bytes requested by attached editors. compare with ReadFnBytes.
+
+    // [Internal State]
+    struct Page
+    {
+        size_t          Addr;                                   // page address (multiple of OptPageSize)
+        int             Frame;                                  // frame it was read, -1 if unused
+    };
+    struct Range
+    {
+        size_t          Min, Max;
+    };
+    ImVector<Page>  Pages;                                      // open addressing hash table on page address
+    ImVector<ImU8>  PagesData;                                  // OptPageSize bytes per page
+    ImVector<Range> Ranges;                                     // merged visible ranges (temporary)
+    ImVector<ImU8>  SpanBuf;                                    // bytes of a span of missing pages (temporary)
+    size_t          CachedPageSize;
+
+    MemoryEditorShared()
+    {
+        OptPageSize = 4096;
+        OptCachePagesCount = 1024;
+        OptMaxAgeFrames = 0;
+        OptBypassSize = 64 * 1024;
+        ReadFn = NULL;
+        WriteFn = NULL;
+        UserData = NULL;
+        ReadFnCalls = 0;
+        ReadFnBytes = RequestedBytes = 0;
+        CachedPageSize = 0;
+    }
+
+    // Route reads and writes of 'editor' through this cache. Pass NULL as mem_data when drawing. Sets ReadOnly when WriteFn is NULL (restored by Detach()).
+    void Attach(MemoryEditor* editor)
+    {
+        editor->ReadFn = NULL;
+        editor->ReadRangeFn = ReadRangeHandler;
+        editor->WriteFn = NULL;
+        editor->WriteRangeFn = WriteFn ? WriteRangeHandler : NULL;
+        editor->UserData = this;
+        if (!Editors.contains(editor))
+        {
+            Editors.push_back(editor);
+            EditorsPrevReadOnly.push_back(editor->ReadOnly);
+        }
+        if (WriteFn == NULL)
+            editor->ReadOnly = true;
+    }
+
+    void Detach(MemoryEditor* editor)
+    {
+        int editor_n = 0;
+        while (editor_n < Editors.Size && Editors[editor_n] != editor)
+            editor_n++;
+        if (editor_n == Editors.Size)
+            return;
+        editor->ReadOnly = EditorsPrevReadOnly[editor_n];
+        Editors.erase(Editors.Data + editor_n);
+        EditorsPrevReadOnly.erase(EditorsPrevReadOnly.Data + editor_n);
+        editor->ReadRangeFn = NULL;
+        editor->WriteRangeFn = NULL;
+        editor->UserData = NULL;
+    }
+
+    // Call once per frame before drawing attached editors: read visible pages of all editors, merging overlapping and adjacent ranges.
+    void NewFrame()
+    {
+        ReadFnCalls = 0;
+        ReadFnBytes = RequestedBytes = 0;
+        UpdateCacheSize();
+
+        // Collect visible ranges of editors drawn last frame, aligned to pages. Skip editors using Regions (their visible range may span collapsed gaps).
+        Ranges.resize(0);
+        for (MemoryEditor* editor : Editors)
+        {
+            if (editor->VisibleFrame < ImGui::GetFrameCount() - 1 || editor->VisibleAddrMin >= editor->VisibleAddrMax || editor->Regions.Size > 0)
+                continue;
+            Range range;
+            range.Min = editor->VisibleAddrMin & ~(OptPageSize - 1);
+            range.Max = ((editor->VisibleAddrMax - 1) & ~(OptPageSize - 1)) + OptPageSize;
+            if (range.Max < range.Min) // Overflow at end of address space
+                range.Max = (size_t)-1 & ~(OptPageSize - 1);
+            Ranges.push_back(range);
+        }
+        if (Ranges.Size == 0)
+            return;
+
+        // Sort (insertion sort: few editors) and merge
+        for (int n = 1; n < Ranges.Size; n++)
+            for (int m = n; m > 0 && Ranges[m].Min < Ranges[m - 1].Min; m--)
+            {
+                Range tmp = Ranges[m];
+                Ranges[m] = Ranges[m - 1];
+                Ranges[m - 1] = tmp;
+            }
+        int merged_count = 1;
+        for (int n = 1; n < Ranges.Size; n++)
+        {
+            Range& last = Ranges[merged_count - 1];
+            if (Ranges[n].Min <= last.Max)
+                last.Max = (Ranges[n].Max > last.Max) ? Ranges[n].Max : last.Max;
+            else
+                Ranges[merged_count++] = Ranges[n];
+        }
+        Ranges.resize(merged_count);
+
+        // Read each span of consecutive missing pages with one call
+        const size_t max_span_size = (size_t)(OptCachePagesCount / 2) * OptPageSize;
+        for (const Range& range : Ranges)
+            for (size_t span_min = range.Min; span_min < range.Max; )
+            {
+                if (FindPage(span_min) != -1)
+                {
+                    span_min += OptPageSize;
+                    continue;
+                }
+                size_t span_max = span_min + OptPageSize;
+                while (span_max < range.Max && span_max - span_min < max_span_size && FindPage(span_max) == -1)
+                    span_max += OptPageSize;
+                ReadSpan(span_min, span_max);
+                span_min = span_max;
+            }
+    }
+
+    // Read bytes, from cache when possible
+    void Read(size_t addr, ImU8* out_buf, size_t size)
+    {
+        RequestedBytes += size;
+        UpdateCacheSize();
+        if (size > OptBypassSize)
+        {
+            CallReadFn(addr, out_buf, size);
+            return;
+        }
+        for (size_t done = 0; done < size; )
+        {
+            const size_t chunk_addr = addr + done;
+            const size_t page_addr = chunk_addr & ~(OptPageSize - 1);
+            int page_n = FindPage(page_addr);
+            if (page_n == -1)
+            {
+                page_n = AllocPage(page_addr);
+                CallReadFn(page_addr, GetPageData(page_n), OptPageSize);
+            }
+            const size_t page_offset = chunk_addr - page_addr;
+            const size_t chunk_size = (OptPageSize - page_offset < size - done) ? OptPageSize - page_offset : size - done;
+            memcpy(out_buf + done, GetPageData(page_n) + page_offset, chunk_size);
+            done += chunk_size;
+        }
+    }
+
+    void Write(size_t addr, const ImU8* buf, size_t size)
+    {
+        if (WriteFn == NULL)
+            return;
+        WriteFn(addr, buf, size, UserData);
+
+        // Update cached pages
+        UpdateCacheSize();
+        for (size_t done = 0; done < size; )
+        {
+            const size_t chunk_addr = addr + done;
+            const size_t page_addr = chunk_addr & ~(OptPageSize - 1);
+            const size_t page_offset = chunk_addr - page_addr;
+            const size_t chunk_size = (OptPageSize - page_offset < size - done) ? OptPageSize - page_offset : size - done;
+            const int page_n = FindPage(page_addr);
+            if (page_n != -1)
+                memcpy(GetPageData(page_n) + page_offset, buf + done, chunk_size);
+            done += chunk_size;
+        }
+    }
+
+    // Discard cached pages overlapping [addr_min, addr_max), e.g. after target memory changed when using OptMaxAgeFrames > 0.
+    void InvalidateCache(size_t addr_min = 0, size_t addr_max = (size_t)-1)
+    {
+        for (Page& page : Pages)
+            if (page.Frame != -1 && page.Addr < addr_max && page.Addr + OptPageSize > addr_min)
+                page.Frame = -1;
+    }
+
+    // [Internal] (Re)allocate cache when settings changed
+    void UpdateCacheSize()
+    {
+        IM_ASSERT(OptPageSize > 0 && (OptPageSize & (OptPageSize - 1)) == 0);
+        IM_ASSERT(OptCachePagesCount > 0 && (OptCachePagesCount & (OptCachePagesCount - 1)) == 0);
+        if (Pages.Size == OptCachePagesCount && CachedPageSize == OptPageSize)
+            return;
+        Pages.resize(OptCachePagesCount);
+        for (Page& page : Pages)
+            page.Frame = -1;
+        IM_ASSERT((size_t)OptCachePagesCount * OptPageSize <= 0x7FFFFFFF && "Cache too large: OptCachePagesCount * OptPageSize must fit in an int.");
+        PagesData.resize((int)((size_t)OptCachePagesCount * OptPageSize));
+        CachedPageSize = OptPageSize;
+    }
+
+    // [Internal] Offset computed in size_t: page_n * OptPageSize may not fit in an int
+    ImU8* GetPageData(int page_n)
+    {
+        return PagesData.Data + (size_t)page_n * OptPageSize;
+    }
+
+    // [Internal] Hash table probing: a page can be stored in one of ProbeCount slots following its hash.
+    enum { ProbeCount = 8 };
+    int GetPageHashSlot(size_t page_addr) const
+    {
+        ImU64 page_index = (ImU64)(page_addr / OptPageSize);
+        page_index *= 0x9E3779B97F4A7C15ULL;
+        return (int)(page_index >> 32) & (Pages.Size - 1);
+    }
+
+    bool IsPageValid(const Page& page) const
+    {
+        return page.Frame != -1 && ImGui::GetFrameCount() - page.Frame <= OptMaxAgeFrames;
+    }
+
+    // [Internal] Return index of a valid cached page, or -1
+    int FindPage(size_t page_addr) const
+    {
+        const int hash_slot = GetPageHashSlot(page_addr);
+        for (int n = 0; n < ProbeCount; n++)
+        {
+            const int page_n = (hash_slot + n) & (Pages.Size - 1);
+            const Page& page = Pages[page_n];
+            if (page.Addr == page_addr && IsPageValid(page))
+                return page_n;
+        }
+        return -1;
+    }
+
+    // [Internal] Return index of slot to store a page: same page (expired), unused or expired slot, otherwise least recently read.
+    int AllocPage(size_t page_addr)
+    {
+        const int hash_slot = GetPageHashSlot(page_addr);
+        int best_n = hash_slot;
+        for (int n = 0; n < ProbeCount; n++)
+        {
+            const int page_n = (hash_slot + n) & (Pages.Size - 1);
+            const Page& page = Pages[page_n];
+            if (page.Addr == page_addr || !IsPageValid(page))
+            {
+                best_n = page_n;
+                break;
+            }
+            if (page.Frame < Pages[best_n].Frame)
+                best_n = page_n;
+        }
+        Pages[best_n].Addr = page_addr;
+        Pages[best_n].Frame = ImGui::GetFrameCount();
+        return best_n;
+    }
+
+    // [Internal] Read [span_min, span_max) with one call and store its pages
+    void ReadSpan(size_t span_min, size_t span_max)
+    {
+        SpanBuf.resize((int)(span_max - span_min));
+        CallReadFn(span_min, SpanBuf.Data, span_max - span_min);
+        for (size_t page_addr = span_min; page_addr < span_max; page_addr += OptPageSize)
+        {
+            const int page_n = AllocPage(page_addr);
+            memcpy(GetPageData(page_n), SpanBuf.Data + (page_addr - span_min), OptPageSize);
+        }
+    }
+
+    void CallReadFn(size_t addr, ImU8* out_buf, size_t size)
+    {
+        ReadFnCalls++;
+        ReadFnBytes += size;
+        if (ReadFn)
+            ReadFn(addr, out_buf, size, UserData);
+        else
+            memset(out_buf, 0, size);
+    }
+
+    static void ReadRangeHandler(const ImU8* mem, size_t off, ImU8* out_buf, size_t size, void* user_data)
+    {
+        IM_UNUSED(mem);
+        ((MemoryEditorShared*)user_data)->Read(off, out_buf, size);
+    }
+
+    static void WriteRangeHandler(ImU8* mem, size_t off, const ImU8* buf, size_t size, void* user_data)
+    {
+        IM_UNUSED(mem);
+        ((MemoryEditorShared*)user_data)->Write(off, buf, size);
+    }
+};
@@ -1,4 +1,4 @@
-// Multi-Context Compositor v0.11, for Dear ImGui
+// Multi-Context Compositor v0.12, for Dear ImGui
 // Get latest version at http://www.github.com/ocornut/imgui_club
 // Licensed under The MIT License (MIT)
 
@@ -11,27 +11,385 @@
 // ImGuiMultiContextCompositor Implementation
 //-----------------------------------------------------------------------------
 
+static ImGuiID ImGuiMultiContextCompositor_GetSlotKey(ImGuiContext* ctx)
+{
+    return ImHashData(&ctx, sizeof(ctx));
+}
+
+// Return slot index of a context, or -1
+static int ImGuiMultiContextCompositor_FindSlot(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
+{
+    const int slot_n = mcc->SlotsMap.GetInt(ImGuiMultiContextCompositor_GetSlotKey(ctx)) - 1;
+    if (slot_n >= 0 && mcc->Slots[slot_n].Ctx == ctx)
+        return slot_n;
+    for (int n = 0; n < mcc->Slots.Size; n++) // Hash collision: not worth handling better
+        if (mcc->Slots[n].Ctx == ctx)
+            return n;
+    return -1;
+}
+
+static void ImGuiMultiContextCompositor_UnlinkSlot(ImGuiMultiContextCompositor* mcc, int slot_n)
+{
+    ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+    if (slot->Prev != -1)
+        mcc->Slots[slot->Prev].Next = slot->Next;
+    else
+        mcc->SlotFront = slot->Next;
+    if (slot->Next != -1)
+        mcc->Slots[slot->Next].Prev = slot->Prev;
+    else
+        mcc->SlotBack = slot->Prev;
+    slot->Prev = slot->Next = -1;
+    mcc->ContextsFrontToBackDirty = true;
+}
+
+static ImGuiContext* ImGuiMultiContextCompositor_GetFrontContext(ImGuiMultiContextCompositor* mcc)
+{
+    return (mcc->SlotFront != -1) ? mcc->Slots[mcc->SlotFront].Ctx : NULL;
+}
+
+const ImVector<ImGuiContext*>& ImGuiMultiContextCompositor_GetContextsFrontToBack(ImGuiMultiContextCompositor* mcc)
+{
+    if (mcc->ContextsFrontToBackDirty)
+    {
+        mcc->ContextsFrontToBackDirty = false;
+        mcc->ContextsFrontToBack.resize(0);
+        for (int slot_n = mcc->SlotFront; slot_n != -1; slot_n = mcc->Slots[slot_n].Next)
+            mcc->ContextsFrontToBack.push_back(mcc->Slots[slot_n].Ctx);
+    }
+    return mcc->ContextsFrontToBack;
+}
+
+// Rebuild hit-testing data after EndFrame(), when windows of every context have been submitted.
+static void ImGuiMultiContextCompositor_UpdateSlotsRects(ImGuiMultiContextCompositor* mcc)
+{
+    mcc->WindowsRects.resize(0);
+    mcc->ExclusiveViewports.resize(0);
+    for (ImGuiMultiContextCompositorSlot& slot : mcc->Slots)
+    {
+        ImGuiContext* ctx = slot.Ctx;
+        if (ctx == NULL)
+            continue;
+        slot.RectsOffset = mcc->WindowsRects.Size;
+        slot.BoundsMin = ImVec2(FLT_MAX, FLT_MAX);
+        slot.BoundsMax = ImVec2(-FLT_MAX, -FLT_MAX);
+        slot.HasModal = false;
+        for (ImGuiWindow* window : ctx->Windows)
+        {
+            if (!window->Active || window->Hidden || (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_NoMouseInputs)))
+                continue;
+            if (window->Flags & ImGuiWindowFlags_Modal)
+                slot.HasModal = true;
+
+            // Same padding as FindHoveredWindowEx()
+            const ImVec2 padding = (window->Flags & (ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize)) ? ctx->Style.TouchExtraPadding : ctx->WindowsHoverPadding;
+            ImGuiMultiContextCompositorRect rect;
+            rect.Min = ImVec2(window->Pos.x - padding.x, window->Pos.y - padding.y);
+            rect.Max = ImVec2(window->Pos.x + window->Size.x + padding.x, window->Pos.y + window->Size.y + padding.y);
+#ifdef IMGUI_HAS_DOCK
+            rect.ViewportId = window->Viewport ? window->Viewport->ID : 0;
+#else
+            rect.ViewportId = 0;
+#endif
+            slot.BoundsMin = ImMin(slot.BoundsMin, rect.Min);
+            slot.BoundsMax = ImMax(slot.BoundsMax, rect.Max);
+            mcc->WindowsRects.push_back(rect);
+        }
+        slot.RectsCount = mcc->WindowsRects.Size - slot.RectsOffset;
+
+        slot.ExclusiveViewportsOffset = mcc->ExclusiveViewports.Size;
+#ifdef IMGUI_HAS_DOCK
+        for (ImGuiViewport* viewport : ctx->PlatformIO.Viewports)
+            if ((viewport->Flags & ImGuiViewportFlags_CanHostOtherWindows) == 0)
+                mcc->ExclusiveViewports.push_back(viewport->ID);
+#endif
+        slot.ExclusiveViewportsCount = mcc->ExclusiveViewports.Size - slot.ExclusiveViewportsOffset;
+        slot.RectsValid = true;
+    }
+}
+
+// Hit-test a context windows. When viewport_id != 0 only windows on this viewport are tested.
+static bool ImGuiMultiContextCompositor_HitTestSlot(ImGuiMultiContextCompositor* mcc, const ImGuiMultiContextCompositorSlot* slot, ImVec2 pos, ImGuiID viewport_id)
+{
+    if (slot->HasModal)
+        return true;
+    if (pos.x < slot->BoundsMin.x || pos.y < slot->BoundsMin.y || pos.x >= slot->BoundsMax.x || pos.y >= slot->BoundsMax.y)
+        return false;
+    for (int n = 0; n < slot->RectsCount; n++)
+    {
+        const ImGuiMultiContextCompositorRect& rect = mcc->WindowsRects[slot->RectsOffset + n];
+        if ((viewport_id == 0 || rect.ViewportId == viewport_id) && pos.x >= rect.Min.x && pos.y >= rect.Min.y && pos.x < rect.Max.x && pos.y < rect.Max.y)
+            return true;
+    }
+    return false;
+}
+
+// Latest mouse position submitted by backend, not yet processed by NewFrame()
+static ImVec2 ImGuiMultiContextCompositor_GetLatestMousePos(ImGuiContext* ctx)
+{
+    for (int n = ctx->InputEventsQueue.Size - 1; n >= 0; n--)
+        if (ctx->InputEventsQueue[n].Type == ImGuiInputEventType_MousePos)
+            return ImVec2(ctx->InputEventsQueue[n].MousePos.PosX, ctx->InputEventsQueue[n].MousePos.PosY);
+    return ctx->IO.MousePos;
+}
+
+// Return true if inputs submitted by backend since last NewFrame() are routed to this context
+static bool ImGuiMultiContextCompositor_HasRoutedInputEvents(ImGuiContext* ctx, bool mouse_pos_routed)
+{
+    const bool mouse_routed = (ctx->IO.ConfigFlags & ImGuiConfigFlags_NoMouse) == 0;
+    const bool keyboard_routed = (ctx->IO.ConfigFlags & ImGuiConfigFlags_NoKeyboard) == 0;
+    for (const ImGuiInputEvent& e : ctx->InputEventsQueue)
+    {
+        if (e.Type == ImGuiInputEventType_Key || e.Type == ImGuiInputEventType_Text)
+        {
+            if (keyboard_routed)
+                return true;
+        }
+        else if (e.Type == ImGuiInputEventType_Focus)
+            return true;
+        else if (e.Type == ImGuiInputEventType_MouseButton)
+        {
+            if (mouse_routed)
+                return true;
+        }
+        else if (mouse_routed && mouse_pos_routed) // Mouse position, wheel, viewport
+            return true;
+    }
+    return false;
+}
+
+// Idle context: discard inputs it wouldn't use, but keep latest mouse position for hit-testing.
+static void ImGuiMultiContextCompositor_DiscardInputEvents(ImGuiContext* ctx)
+{
+    int mouse_pos_n = -1;
+    for (int n = ctx->InputEventsQueue.Size - 1; n >= 0 && mouse_pos_n == -1; n--)
+        if (ctx->InputEventsQueue[n].Type == ImGuiInputEventType_MousePos)
+            mouse_pos_n = n;
+    if (mouse_pos_n != -1)
+        ctx->InputEventsQueue[0] = ctx->InputEventsQueue[mouse_pos_n];
+    ctx->InputEventsQueue.resize(mouse_pos_n != -1 ? 1 : 0);
+}
+
+static void ImGuiMultiContextCompositor_UpdateContextsToUpdate(ImGuiMultiContextCompositor* mcc)
+{
+    mcc->ContextsToUpdate.resize(0);
+    for (ImGuiContext* ctx : mcc->Contexts)
+    {
+        ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[ImGuiMultiContextCompositor_FindSlot(mcc, ctx)];
+        if (mcc->SkipIdleContexts)
+        {
+            const bool mouse_pos_routed = slot->Hovered || slot->WasHovered || ctx->IO.WantCaptureMouse;
+            bool active = slot->Dirty || !slot->RectsValid;
+            active |= (ctx == mcc->CtxDragDropSrc || ctx == mcc->CtxDragDropDst);
+            active |= (ctx->ActiveId != 0 || ctx->HoveredId != 0);
+            active |= (ctx->IO.DisplaySize.x != slot->LastDisplaySize.x || ctx->IO.DisplaySize.y != slot->LastDisplaySize.y);
+            active |= ImGuiMultiContextCompositor_HasRoutedInputEvents(ctx, mouse_pos_routed);
+            slot->IdleFrames = active ? 0 : slot->IdleFrames + 1;
+            slot->NeedsUpdate = (slot->IdleFrames <= mcc->SkipIdleContextsDelay);
+        }
+        else
+        {
+            slot->NeedsUpdate = true;
+        }
+        slot->WasHovered = slot->Hovered;
+        if (!slot->NeedsUpdate)
+        {
+            ImGuiMultiContextCompositor_DiscardInputEvents(ctx);
+            continue;
+        }
+        slot->Dirty = false;
+        slot->LastDisplaySize = ctx->IO.DisplaySize;
+        mcc->ContextsToUpdate.push_back(ctx);
+    }
+}
+
+bool ImGuiMultiContextCompositor_ContextNeedsUpdate(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
+{
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    return slot_n == -1 || mcc->Slots[slot_n].NeedsUpdate;
+}
+
+void ImGuiMultiContextCompositor_SetContextDirty(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
+{
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    if (slot_n != -1)
+        mcc->Slots[slot_n].Dirty = true;
+}
+
+// Record NewFrame()/Render() pre/post times. Called from thread updating 'ctx': only writes to its own slot.
+static void ImGuiMultiContextCompositor_StatsHook(ImGuiContext* ctx, ImGuiContextHook* hook)
+{
+    ImGuiMultiContextCompositor* mcc = (ImGuiMultiContextCompositor*)hook->UserData;
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    if (slot_n == -1 || mcc->GetTimeFn == NULL)
+        return;
+    int time_n;
+    switch (hook->Type)
+    {
+    case ImGuiContextHookType_NewFramePre:  time_n = 0; break;
+    case ImGuiContextHookType_NewFramePost: time_n = 1; break;
+    case ImGuiContextHookType_RenderPre:    time_n = 2; break;
+    case ImGuiContextHookType_RenderPost:   time_n = 3; break;
+    default: return;
+    }
+    mcc->Slots[slot_n].StatsHookTimes[time_n] = mcc->GetTimeFn(mcc->UserData);
+}
+
+// Publish statistics after all contexts are rendered
+static void ImGuiMultiContextCompositor_UpdateStats(ImGuiMultiContextCompositor* mcc)
+{
+    const int history_n = mcc->StatsHistoryOffset;
+    mcc->StatsHistoryDeltaTime[history_n] = (mcc->SlotFront != -1) ? ImGuiMultiContextCompositor_GetFrontContext(mcc)->IO.DeltaTime : 0.0f;
+    mcc->StatsHistoryFocusChanges[history_n] = mcc->StatsFrameFocusChanges;
+    mcc->StatsHistoryMouseRoutingChanges[history_n] = mcc->StatsFrameMouseRoutingChanges;
+    mcc->StatsFrameFocusChanges = mcc->StatsFrameMouseRoutingChanges = 0;
+    mcc->StatsHistoryOffset = (history_n + 1) % ImGuiMultiContextCompositor_StatsHistorySize;
+
+    float total_time = 0.0f;
+    int total_focus_changes = 0, total_mouse_routing_changes = 0;
+    for (int n = 0; n < ImGuiMultiContextCompositor_StatsHistorySize; n++)
+    {
+        total_time += mcc->StatsHistoryDeltaTime[n];
+        total_focus_changes += mcc->StatsHistoryFocusChanges[n];
+        total_mouse_routing_changes += mcc->StatsHistoryMouseRoutingChanges[n];
+    }
+    mcc->FocusChangesPerSecond = (total_time > 0.0f) ? total_focus_changes / total_time : 0.0f;
+    mcc->MouseRoutingChangesPerSecond = (total_time > 0.0f) ? total_mouse_routing_changes / total_time : 0.0f;
+
+    for (ImGuiMultiContextCompositorSlot& slot : mcc->Slots)
+    {
+        ImGuiContext* ctx = slot.Ctx;
+        if (ctx == NULL)
+            continue;
+        ImGuiMultiContextCompositorStats* stats = &slot.Stats;
+        stats->Updated = slot.NeedsUpdate;
+        stats->Hovered = slot.Hovered;
+        stats->MouseRouted = (ctx->IO.ConfigFlags & ImGuiConfigFlags_NoMouse) == 0;
+        stats->KeyboardRouted = (ctx->IO.ConfigFlags & ImGuiConfigFlags_NoKeyboard) == 0;
+        const double* times = slot.StatsHookTimes;
+        if (stats->Updated && slot.StatsHookIds[0] != 0 && times[0] <= times[1] && times[1] <= times[2] && times[2] <= times[3])
+        {
+            stats->NewFrameMs = (float)((times[1] - times[0]) * 1000.0);
+            stats->BuildMs = (float)((times[2] - times[1]) * 1000.0);
+            stats->RenderMs = (float)((times[3] - times[2]) * 1000.0);
+        }
+        else
+        {
+            stats->NewFrameMs = stats->BuildMs = stats->RenderMs = 0.0f;
+        }
+        stats->VtxCount = stats->IdxCount = 0;
+        for (ImGuiViewportP* viewport : ctx->Viewports)
+            if (viewport->DrawDataP.Valid)
+            {
+                stats->VtxCount += viewport->DrawDataP.TotalVtxCount;
+                stats->IdxCount += viewport->DrawDataP.TotalIdxCount;
+            }
+        slot.StatsHistoryMs[history_n] = stats->NewFrameMs + stats->BuildMs + stats->RenderMs;
+    }
+}
+
 void ImGuiMultiContextCompositor_AddContext(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
 {
-    IM_ASSERT(mcc->Contexts.contains(ctx) == false);
+    IM_ASSERT(ImGuiMultiContextCompositor_FindSlot(mcc, ctx) == -1);
+    int slot_n = mcc->SlotFreeList;
+    if (slot_n != -1)
+        mcc->SlotFreeList = mcc->Slots[slot_n].Prev;
+    else
+    {
+        slot_n = mcc->Slots.Size;
+        mcc->Slots.push_back(ImGuiMultiContextCompositorSlot());
+    }
+
+    // Link at the back
+    ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+    slot->Ctx = ctx;
+    slot->RectsValid = false;
+    slot->Hovered = slot->WasHovered = false;
+    slot->Dirty = false;
+    slot->NeedsUpdate = true;
+    slot->IdleFrames = 0;
+    slot->Stats = ImGuiMultiContextCompositorStats();
+    memset(slot->StatsHistoryMs, 0, sizeof(slot->StatsHistoryMs));
+    memset(slot->StatsHookTimes, 0, sizeof(slot->StatsHookTimes));
+    memset(slot->StatsHookIds, 0, sizeof(slot->StatsHookIds));
+    if (mcc->GetTimeFn != NULL)
+    {
+        const ImGuiContextHookType hook_types[4] = { ImGuiContextHookType_NewFramePre, ImGuiContextHookType_NewFramePost, ImGuiContextHookType_RenderPre, ImGuiContextHookType_RenderPost };
+        for (int n = 0; n < 4; n++)
+        {
+            ImGuiContextHook hook;
+            hook.Type = hook_types[n];
+            hook.Callback = ImGuiMultiContextCompositor_StatsHook;
+            hook.UserData = mcc;
+            slot->StatsHookIds[n] = ImGui::AddContextHook(ctx, &hook);
+        }
+    }
+    slot->Prev = mcc->SlotBack;
+    slot->Next = -1;
+    if (mcc->SlotBack != -1)
+        mcc->Slots[mcc->SlotBack].Next = slot_n;
+    else
+        mcc->SlotFront = slot_n;
+    mcc->SlotBack = slot_n;
+    const ImGuiID key = ImGuiMultiContextCompositor_GetSlotKey(ctx);
+    if (mcc->SlotsMap.GetInt(key) == 0)
+        mcc->SlotsMap.SetInt(key, slot_n + 1);
+
+    slot->ContextsIndex = mcc->Contexts.Size;
     mcc->Contexts.push_back(ctx);
-    mcc->ContextsFrontToBack.push_back(ctx);
+    mcc->ContextsFrontToBackDirty = true;
 }
 
 void ImGuiMultiContextCompositor_RemoveContext(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
 {
-    mcc->Contexts.find_erase(ctx);
-    mcc->ContextsFrontToBack.find_erase(ctx);
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    if (slot_n == -1)
+        return;
+    ImGuiMultiContextCompositor_UnlinkSlot(mcc, slot_n);
+    ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+    for (ImGuiID hook_id : slot->StatsHookIds)
+        if (hook_id != 0)
+            ImGui::RemoveContextHook(ctx, hook_id);
+    const ImGuiID key = ImGuiMultiContextCompositor_GetSlotKey(ctx);
+    if (mcc->SlotsMap.GetInt(key) == slot_n + 1)
+        mcc->SlotsMap.SetInt(key, 0);
+
+    // Move last context into the removed one's index
+    ImGuiContext* last_ctx = mcc->Contexts.back();
+    if (last_ctx != ctx)
+    {
+        mcc->Contexts[slot->ContextsIndex] = last_ctx;
+        mcc->Slots[ImGuiMultiContextCompositor_FindSlot(mcc, last_ctx)].ContextsIndex = slot->ContextsIndex;
+    }
+    mcc->Contexts.pop_back();
+
+    slot->Ctx = NULL;
+    slot->ContextsIndex = -1;
+    slot->Prev = mcc->SlotFreeList;
+    mcc->SlotFreeList = slot_n;
 }
 
 static void ImGuiMultiContextCompositor_BringContextToFront(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx, ImGuiContext* ctx_to_keep_inputs_for)
 {
-    mcc->ContextsFrontToBack.find_erase(ctx);
-    mcc->ContextsFrontToBack.push_front(ctx);
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    if (slot_n == -1 || slot_n == mcc->SlotFront)
+        return;
+    ImGuiContext* prev_front_ctx = mcc->Slots[mcc->SlotFront].Ctx;
+    ImGuiMultiContextCompositor_UnlinkSlot(mcc, slot_n);
+    ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+    slot->Next = mcc->SlotFront;
+    if (mcc->SlotFront != -1)
+        mcc->Slots[mcc->SlotFront].Prev = slot_n;
+    else
+        mcc->SlotBack = slot_n;
+    mcc->SlotFront = slot_n;
 
-    for (ImGuiContext* other_ctx : mcc->ContextsFrontToBack)
-        if (other_ctx != ctx && other_ctx != ctx_to_keep_inputs_for)
-            other_ctx->IO.ClearInputKeys();
+    // Only the previous keyboard owner may have keys held: other contexts have ImGuiConfigFlags_NoKeyboard, making NewFrame() clear their keys.
+    if (prev_front_ctx != ctx && prev_front_ctx != ctx_to_keep_inputs_for)
+        prev_front_ctx->IO.ClearInputKeys();
+    ImGuiContext* prev_keyboard_ctx = mcc->CtxKeyboardExclusive;
+    if (prev_keyboard_ctx != NULL && prev_keyboard_ctx != prev_front_ctx && prev_keyboard_ctx != ctx && prev_keyboard_ctx != ctx_to_keep_inputs_for)
+        prev_keyboard_ctx->IO.ClearInputKeys();
 }
 
 static bool ImGuiMultiContextCompositor_DragDropGetPayloadFromSourceContext(ImGuiMultiContextCompositor* mcc)
@@ -44,9 +402,25 @@ static bool ImGuiMultiContextCompositor_DragDropGetPayloadFromSourceContext(ImGu
     if (src_ctx->DragDropSourceFlags & ImGuiDragDropFlags_PayloadNoCrossContext)
         return false;
     ImGuiPayload* src_payload = &src_ctx->DragDropPayload;
+    if (mcc->DragDropPayloadNoCopy && mcc->ParallelForFn == NULL)
+    {
+        mcc->DragDropPayloadChanged = true;
+        *dst_payload = *src_payload;
+        return true;
+    }
+
+    // Only copy when payload changed (comparing is cheaper than reallocating and copying every frame)
+    ImVector<unsigned char>& buf = mcc->DragDropPayloadBufHeap;
+    const ImGuiPayload* prev_payload = dst_payload; // Previous frame payload
+    mcc->DragDropPayloadChanged = (prev_payload->SourceId != src_payload->SourceId || strcmp(prev_payload->DataType, src_payload->DataType) != 0 || buf.Size != src_payload->DataSize || (buf.Size > 0 && memcmp(buf.Data, src_payload->Data, (size_t)buf.Size) != 0));
+    if (mcc->DragDropPayloadChanged)
+    {
+        buf.resize(src_payload->DataSize);
+        if (buf.Size > 0)
+            memcpy(buf.Data, src_payload->Data, (size_t)buf.Size);
+    }
     *dst_payload = *src_payload;
-    dst_payload->Data = ImGui::MemAlloc(src_payload->DataSize);
-    memcpy(dst_payload->Data, src_payload->Data, src_payload->DataSize);
+    dst_payload->Data = buf.Data;
     return true;
 }
 
@@ -54,19 +428,21 @@ static void MultiContext_DragDropSetPayloadToDestContext(ImGuiMultiContextCompos
 {
     IM_ASSERT(dst_ctx == ImGui::GetCurrentContext());
     ImGuiPayload* src_payload = &mcc->DragDropPayload;
+    if (mcc->DragDropPayloadNoCopy && mcc->ParallelForFn == NULL)
+    {
+        // Source context may have ended drag and drop (freeing its payload) during its own frame
+        ImGuiContext* src_ctx = mcc->CtxDragDropSrc;
+        if (!src_ctx->DragDropActive || src_ctx->DragDropPayload.Data != src_payload->Data || src_ctx->DragDropPayload.DataSize != src_payload->DataSize)
+            return;
+    }
     if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceExtern | ImGuiDragDropFlags_SourceNoPreviewTooltip))
     {
-        ImGui::SetDragDropPayload(src_payload->DataType, src_payload->Data, src_payload->DataSize);
+        // ImGuiCond_Once: destination context keeps its own copy until payload changes.
+        ImGui::SetDragDropPayload(src_payload->DataType, src_payload->Data, (size_t)src_payload->DataSize, mcc->DragDropPayloadChanged ? ImGuiCond_Always : ImGuiCond_Once);
         ImGui::EndDragDropSource();
     }
 }
 
-static void MultiContext_DragDropFreePayload(ImGuiPayload* src_payload)
-{
-    ImGui::MemFree(src_payload->Data);
-    src_payload->Data = NULL;
-}
-
 void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextCompositor* mcc)
 {
     // Clear transient data
@@ -76,25 +452,37 @@ void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextComposito
     mcc->CtxKeyboardExclusive = NULL;
     mcc->CtxDragDropSrc = NULL;
     mcc->CtxDragDropDst = NULL;
-    mcc->DragDropPayload.Clear();
 
     // Sync point (before NewFrame calls)
     // PASS 1:
     // - Find out who will receive mouse position (one or multiple contexts)
     // - FInd out who will change mouse cursor (one context)
     // - Find out who has an active drag and drop
-    for (ImGuiContext* ctx : mcc->ContextsFrontToBack)
+    for (int slot_n = mcc->SlotFront; slot_n != -1; slot_n = mcc->Slots[slot_n].Next)
     {
+        ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+        ImGuiContext* ctx = slot->Ctx;
+        ImGuiID hovered_viewport_id = 0;
 #ifdef IMGUI_HAS_DOCK
         // When hovering a secondary viewport, only enable mouse for the context owning it
         // We specifically use 'ctx->IO.MouseHoveredViewport' (current, submitted by backend) and not 'ctx->MouseLastHoveredViewport' (last valid one)
-        if (mcc->CtxMouseExclusive == NULL && ctx->IO.MouseHoveredViewport != 0)
+        hovered_viewport_id = ctx->IO.MouseHoveredViewport;
+        if (mcc->CtxMouseExclusive == NULL && hovered_viewport_id != 0)
         {
-            ImGuiViewport* hovered_viewport = NULL;
-            for (ImGuiViewport* viewport : ctx->PlatformIO.Viewports)
-                if (viewport->ID == ctx->IO.MouseHoveredViewport)
-                    hovered_viewport = viewport;
-            if (hovered_viewport != NULL && (hovered_viewport->Flags & ImGuiViewportFlags_CanHostOtherWindows) == 0)
+            bool hovered_viewport_is_exclusive = false;
+            if (slot->RectsValid)
+            {
+                for (int n = 0; n < slot->ExclusiveViewportsCount; n++)
+                    if (mcc->ExclusiveViewports[slot->ExclusiveViewportsOffset + n] == hovered_viewport_id)
+                        hovered_viewport_is_exclusive = true;
+            }
+            else
+            {
+                for (ImGuiViewport* viewport : ctx->PlatformIO.Viewports)
+                    if (viewport->ID == hovered_viewport_id && (viewport->Flags & ImGuiViewportFlags_CanHostOtherWindows) == 0)
+                        hovered_viewport_is_exclusive = true;
+            }
+            if (hovered_viewport_is_exclusive)
                 mcc->CtxMouseExclusive = ctx;
         }
 
@@ -106,12 +494,29 @@ void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextComposito
 #endif
 
         // When hovering a main/shared viewport,
-        // - feed mouse front-to-back until reaching context that has io.WantCaptureMouse.
+        // - feed mouse front-to-back until reaching context with a window under current mouse position (hit-tested against rectangles cached at end of previous frame),
+        //   or context that has io.WantCaptureMouse while holding a mouse button (e.g. dragging an item outside of its window).
         // - track second context to pass drag and drop payload
-        if (ctx->IO.WantCaptureMouse && mcc->CtxMouseFirst == NULL)
+        bool ctx_hovered;
+        bool ctx_want_mouse;
+        if (slot->RectsValid)
+        {
+            bool any_mouse_down = false;
+            for (bool down : ctx->IO.MouseDown)
+                any_mouse_down |= down;
+            ctx_hovered = ImGuiMultiContextCompositor_HitTestSlot(mcc, slot, ImGuiMultiContextCompositor_GetLatestMousePos(ctx), hovered_viewport_id);
+            ctx_want_mouse = ctx_hovered || (any_mouse_down && ctx->IO.WantCaptureMouse);
+        }
+        else
+        {
+            ctx_hovered = (ctx->HoveredWindowBeforeClear != NULL);
+            ctx_want_mouse = ctx->IO.WantCaptureMouse;
+        }
+        if (ctx_want_mouse && mcc->CtxMouseFirst == NULL)
             mcc->CtxMouseFirst = ctx;
-        if (ctx->HoveredWindowBeforeClear != NULL && mcc->CtxDragDropDst == NULL)
+        if (ctx_hovered && mcc->CtxDragDropDst == NULL)
             mcc->CtxDragDropDst = ctx;
+        slot->Hovered = ctx_hovered;
 
         // Who owns mouse shape?
         if (mcc->CtxMouseShape == NULL && ctx->MouseCursor != ImGuiMouseCursor_Arrow)
@@ -126,12 +531,19 @@ void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextComposito
 
     // If no secondary viewport are focused, we'll keep keyboard to top-most context
     if (mcc->CtxKeyboardExclusive == NULL)
-        mcc->CtxKeyboardExclusive = mcc->ContextsFrontToBack.front();
+        mcc->CtxKeyboardExclusive = ImGuiMultiContextCompositor_GetFrontContext(mcc);
 
-    // Deep copy payload for replication
+    // Copy payload for replication
+    bool has_payload = false;
     if (mcc->CtxDragDropSrc)
-        ImGuiMultiContextCompositor_DragDropGetPayloadFromSourceContext(mcc);
-    if (mcc->CtxDragDropDst && mcc->DragDropPayload.Data == NULL)
+        has_payload = ImGuiMultiContextCompositor_DragDropGetPayloadFromSourceContext(mcc);
+    if (!has_payload)
+    {
+        mcc->DragDropPayload.Clear();
+        mcc->DragDropPayloadBufHeap.clear();
+        mcc->DragDropPayloadChanged = false;
+    }
+    if (mcc->CtxDragDropDst && !has_payload)
         mcc->CtxDragDropDst = NULL;
 
     // Bring drag target context to front when using DragDropHold press
@@ -143,21 +555,25 @@ void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextComposito
     //   of one ImDrawData would be moved to another ImDrawData.
     // - Solution 3 ? somehow find a way to enforce tooltip always on own viewport, always on top?
     // Ultimately this is not so important, it's already quite a fun luxury to have cross context DND.
-#if 0
-    if (mcc->CtxDragDropDst && mcc->CtxDragDropDst != mcc->ContextsFrontToBack.front())
-        if (mcc->CtxDragDropDst->DragDropHoldJustPressedId != 0)
-            ImGuiMultiContextCompositor_BringContextToFront(mcc, mcc->CtxDragDropDst, mcc->ContextsFrontToBack.front());
-#endif
+    // Solution 2 is implemented by ImGuiMultiContextCompositor_GetMergedDrawData(), so we enable this when it is used.
+    if (mcc->MergedDrawDataUsed)
+        if (mcc->CtxDragDropDst && mcc->CtxDragDropDst != ImGuiMultiContextCompositor_GetFrontContext(mcc))
+            if (mcc->CtxDragDropDst->DragDropHoldJustPressedId != 0)
+                ImGuiMultiContextCompositor_BringContextToFront(mcc, mcc->CtxDragDropDst, ImGuiMultiContextCompositor_GetFrontContext(mcc));
 
     // PASS 2:
     // - Enable/disable mouse interactions on selected contexts.
     // - Enable/disable mouse cursor change so only 1 context can do it.
     // - Bring a context to front whenever clicked any of its windows.
+    // - Walk slots links: a context brought to front is relinked before its successor is read, so it isn't visited again.
     bool is_above_ctx_with_mouse_first = true;
-    for (ImGuiContext* ctx : mcc->ContextsFrontToBack)
+    ImGuiContext* front_ctx = ImGuiMultiContextCompositor_GetFrontContext(mcc);
+    for (int slot_n = mcc->SlotFront, next_slot_n = -1; slot_n != -1; slot_n = next_slot_n)
     {
+        next_slot_n = mcc->Slots[slot_n].Next;
+        ImGuiContext* ctx = mcc->Slots[slot_n].Ctx;
         ImGuiIO& io = ctx->IO;
-        const bool ctx_is_front = (ctx == mcc->ContextsFrontToBack.front());
+        const bool ctx_is_front = (ctx == front_ctx);
 
         // Focused secondary viewport or top-most context in shared viewport gets keyboard
         if (mcc->CtxKeyboardExclusive == ctx)
@@ -201,6 +617,23 @@ void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextComposito
         if (mcc->CtxMouseFirst == ctx)
             is_above_ctx_with_mouse_first = false;
     }
+
+    // PASS 3:
+    // - Find out which contexts need to be updated (when using SkipIdleContexts)
+    ImGuiMultiContextCompositor_UpdateContextsToUpdate(mcc);
+
+    // Statistics
+    ImGuiContext* ctx_mouse = mcc->CtxMouseExclusive ? mcc->CtxMouseExclusive : mcc->CtxMouseFirst;
+    if (mcc->StatsCtxKeyboardPrev != mcc->CtxKeyboardExclusive)
+        mcc->StatsFrameFocusChanges++;
+    if (mcc->StatsCtxMousePrev != ctx_mouse)
+        mcc->StatsFrameMouseRoutingChanges++;
+    mcc->FocusChanges += mcc->StatsFrameFocusChanges;
+    mcc->MouseRoutingChanges += mcc->StatsFrameMouseRoutingChanges;
+    mcc->StatsCtxKeyboardPrev = mcc->CtxKeyboardExclusive;
+    mcc->StatsCtxMousePrev = ctx_mouse;
+    for (ImGuiMultiContextCompositorSlot& slot : mcc->Slots)
+        memset(slot.StatsHookTimes, 0, sizeof(slot.StatsHookTimes));
 }
 
 // This could technically be registered as a hook, but it would make things too magical.
@@ -215,9 +648,86 @@ void ImGuiMultiContextCompositor_PostNewFrameUpdateOne(ImGuiMultiContextComposit
 
 void ImGuiMultiContextCompositor_PostEndFrameUpdateAll(ImGuiMultiContextCompositor* mcc)
 {
-    // Clear drag and drop payload
-    if (mcc->DragDropPayload.Data != NULL)
-        MultiContext_DragDropFreePayload(&mcc->DragDropPayload);
+    // Cache windows rectangles for next frame mouse routing
+    ImGuiMultiContextCompositor_UpdateSlotsRects(mcc);
+
+    ImGuiMultiContextCompositor_UpdateStats(mcc);
+}
+
+const ImGuiMultiContextCompositorStats* ImGuiMultiContextCompositor_GetContextStats(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx)
+{
+    const int slot_n = ImGuiMultiContextCompositor_FindSlot(mcc, ctx);
+    return (slot_n != -1) ? &mcc->Slots[slot_n].Stats : NULL;
+}
+
+// Called by ParallelForFn, possibly from a worker thread: only reads from 'mcc' and writes to its own context.
+static void ImGuiMultiContextCompositor_NewFrameRenderJob(void* job_data, int job_n)
+{
+    ImGuiMultiContextCompositor* mcc = (ImGuiMultiContextCompositor*)job_data;
+    ImGuiContext* ctx = mcc->ContextsToUpdate[job_n];
+    ImGuiContext* prev_ctx = ImGui::GetCurrentContext(); // Job system may run jobs on calling thread
+    ImGui::SetCurrentContext(ctx);
+    ImGui::NewFrame();
+    ImGuiMultiContextCompositor_PostNewFrameUpdateOne(mcc, ctx);
+    if (mcc->ContextFrameFn)
+        mcc->ContextFrameFn(mcc, ctx, mcc->UserData);
+    ImGui::Render();
+    ImGui::SetCurrentContext(prev_ctx);
+}
+
+void ImGuiMultiContextCompositor_NewFrameRenderAll(ImGuiMultiContextCompositor* mcc)
+{
+    ImGuiMultiContextCompositor_PreNewFrameUpdateAll(mcc);
+
+    // Parallel phase: 'mcc' is read-only until all jobs are done (join)
+    if (mcc->ParallelForFn && mcc->ContextsToUpdate.Size > 1)
+        mcc->ParallelForFn(ImGuiMultiContextCompositor_NewFrameRenderJob, mcc, mcc->ContextsToUpdate.Size, mcc->UserData);
+    else
+        for (int ctx_n = 0; ctx_n < mcc->ContextsToUpdate.Size; ctx_n++)
+            ImGuiMultiContextCompositor_NewFrameRenderJob(mcc, ctx_n);
+}
+
+ImDrawData* ImGuiMultiContextCompositor_GetMergedDrawData(ImGuiMultiContextCompositor* mcc)
+{
+    ImDrawData* merged_draw_data = &mcc->MergedDrawData;
+    merged_draw_data->Clear();
+    mcc->MergedTopDrawLists.resize(0);
+    mcc->MergedDrawDataUsed = true;
+
+    // Back to front
+    for (int slot_n = mcc->SlotBack; slot_n != -1; slot_n = mcc->Slots[slot_n].Prev)
+    {
+        ImGuiContext* ctx = mcc->Slots[slot_n].Ctx;
+        ImGuiViewportP* viewport = ctx->Viewports[0];
+        ImDrawData* draw_data = &viewport->DrawDataP; // Also valid without docking branch
+        if (!draw_data->Valid)
+            continue;
+        if (!merged_draw_data->Valid)
+        {
+            merged_draw_data->Valid = true;
+            merged_draw_data->DisplayPos = draw_data->DisplayPos;
+            merged_draw_data->DisplaySize = draw_data->DisplaySize;
+            merged_draw_data->FramebufferScale = draw_data->FramebufferScale;
+            merged_draw_data->OwnerViewport = viewport;
+        }
+
+        // Tooltips windows (and their child windows) and foreground draw list are drawn after all contexts
+        mcc->MergedTooltipDrawLists.resize(0);
+        for (ImGuiWindow* window : ctx->Windows)
+            if (window->Active && (window->RootWindow->Flags & ImGuiWindowFlags_Tooltip))
+                mcc->MergedTooltipDrawLists.push_back(window->DrawList);
+        for (ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            if (draw_list == viewport->BgFgDrawLists[1] || mcc->MergedTooltipDrawLists.contains(draw_list))
+                mcc->MergedTopDrawLists.push_back(draw_list);
+            else
+                merged_draw_data->AddDrawList(draw_list);
+        }
+    }
+    for (ImDrawList* draw_list : mcc->MergedTopDrawLists)
+        merged_draw_data->AddDrawList(draw_list);
+
+    return merged_draw_data;
 }
 
 void ImGuiMultiContextCompositor_ShowDebugWindow(ImGuiMultiContextCompositor* mcc)
@@ -227,12 +737,33 @@ void ImGuiMultiContextCompositor_ShowDebugWindow(ImGuiMultiContextCompositor* mc
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.0f, 0.0f, 1.0f));
     ImGui::Begin("Multi-Context Compositor Overlay", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoInputs);
     ImGui::SeparatorText("Multi-Context Compositor");
-    ImGui::Text("Front: %s", mcc->ContextsFrontToBack.front()->ContextName);
+    ImGui::Text("Front: %s", mcc->SlotFront != -1 ? ImGuiMultiContextCompositor_GetFrontContext(mcc)->ContextName : "");
     ImGui::Text("MousePos first: %s", mcc->CtxMouseFirst ? mcc->CtxMouseFirst->ContextName : "");
     ImGui::Text("MousePos excl.: %s", mcc->CtxMouseExclusive ? mcc->CtxMouseExclusive->ContextName : "");
     ImGui::Text("Keyboard excl.: %s", mcc->CtxKeyboardExclusive ? mcc->CtxKeyboardExclusive->ContextName : "");
     ImGui::Text("DragDrop src: %s", mcc->CtxDragDropSrc ? mcc->CtxDragDropSrc->ContextName : "");
     ImGui::Text("DragDrop dst: %s", mcc->CtxDragDropDst ? mcc->CtxDragDropDst->ContextName : "");
+
+    // Statistics, front to back. Frame time history of all contexts use the same scale.
+    ImGui::SeparatorText("Statistics");
+    ImGui::Text("Focus changes: %.1f/s (%d)", mcc->FocusChangesPerSecond, mcc->FocusChanges);
+    ImGui::Text("Mouse routing changes: %.1f/s (%d)", mcc->MouseRoutingChangesPerSecond, mcc->MouseRoutingChanges);
+    float history_max_ms = 1.0f;
+    for (const ImGuiMultiContextCompositorSlot& slot : mcc->Slots)
+        if (slot.Ctx != NULL)
+            for (float ms : slot.StatsHistoryMs)
+                history_max_ms = (ms > history_max_ms) ? ms : history_max_ms;
+    for (int slot_n = mcc->SlotFront; slot_n != -1; slot_n = mcc->Slots[slot_n].Next)
+    {
+        const ImGuiMultiContextCompositorSlot* slot = &mcc->Slots[slot_n];
+        const ImGuiMultiContextCompositorStats* stats = &slot->Stats;
+        ImGui::PushID(slot->Ctx);
+        ImGui::Text("%s: %s %s%s%s", slot->Ctx->ContextName, stats->Updated ? "Updated" : "Idle", stats->Hovered ? "Hovered " : "", stats->MouseRouted ? "Mouse " : "", stats->KeyboardRouted ? "Keyboard" : "");
+        ImGui::Text("  NewFrame %.2f ms, Build %.2f ms, Render %.2f ms, %d vtx, %d idx", stats->NewFrameMs, stats->BuildMs, stats->RenderMs, stats->VtxCount, stats->IdxCount);
+        if (mcc->GetTimeFn != NULL)
+            ImGui::PlotLines("##History", slot->StatsHistoryMs, ImGuiMultiContextCompositor_StatsHistorySize, mcc->StatsHistoryOffset, NULL, 0.0f, history_max_ms, ImVec2(ImGuiMultiContextCompositor_StatsHistorySize * 2.0f, 30.0f));
+        ImGui::PopID();
+    }
     ImGui::End();
     ImGui::PopStyleColor(2);
 }
@@ -1,4 +1,4 @@
-// Multi-Context Compositor v0.11, for Dear ImGui
+// Multi-Context Compositor v0.12, for Dear ImGui
 // Get latest version at http://www.github.com/ocornut/imgui_club
 // Licensed under The MIT License (MIT)
 
@@ -15,6 +15,21 @@
 // - v0.10: (2024/07/16): initial version. Requires dear imgui 1.90.9+.
 // - v0.11: (2024/08/01): fixed an issue clicking between two secondary viewport of different contexts.
 //                        fixed an issue routing keyboard to secondary viewports. [tom bui]
+// - v0.12: (2026/10/14): added optional threaded driver ImGuiMultiContextCompositor_NewFrameRenderAll(), calling NewFrame()/ContextFrameFn/Render()
+//                        of all contexts in parallel using your job system (ParallelForFn). documented which fields are read-only during the parallel phase.
+//                        z-order is stored as links between per-context slots: bringing a context to front doesn't scale with contexts count anymore,
+//                        and only clears input keys of previous front/keyboard context (other contexts have ImGuiConfigFlags_NoKeyboard, which already clears them).
+//                        ContextsFrontToBack is only built on demand by ImGuiMultiContextCompositor_GetContextsFrontToBack(). RemoveContext() doesn't preserve order of Contexts.
+//                        mouse routing hit-tests current mouse position against top-level windows rectangles cached by PostEndFrameUpdateAll(),
+//                        instead of relying on previous frame io.WantCaptureMouse/hovered window. secondary viewports of each context are cached too.
+//                        drag and drop payload is copied into a persistent buffer only when it changed, instead of being allocated and copied every frame.
+//                        destination context only copies it again when it changed. added DragDropPayloadNoCopy option to use source payload directly.
+//                        added ImGuiMultiContextCompositor_GetMergedDrawData() to render main viewport of all contexts with a single ImDrawData,
+//                        with tooltips and foreground draw lists of all contexts drawn last. drag target context is brought to front on DragDropHold when using it.
+//                        added SkipIdleContexts option and ImGuiMultiContextCompositor_ContextNeedsUpdate(): contexts without routed inputs, drag and drop,
+//                        hovered/active item or dirty flag (ImGuiMultiContextCompositor_SetContextDirty()) may skip NewFrame()/Render() and keep their last ImDrawData.
+//                        added per-context statistics (ImGuiMultiContextCompositor_GetContextStats()): NewFrame/build/Render times when GetTimeFn is set, vertices/indices,
+//                        routing decisions. focus and mouse routing changes per second. ShowDebugWindow() displays them with a frame time history per context.
 
 // TODO:
 // - Ctrl+Tab could be multi-context aware
@@ -44,15 +59,136 @@
     ImGuiMultiContextCompositor_PostEndFrameUpdateAll(mcc);
 */
 
+// USAGE (THREADED):
+/*
+    // Submit UI of one context, called with 'ctx' as current context (possibly from a worker thread)
+    static void MyContextFrame(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx, void* user_data) { ... }
+    // Call job_fn(job_data, 0..jobs_count-1) on your job system and return once they are all done
+    static void MyParallelFor(void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count, void* user_data) { ... }
+    ...
+    mcc->ContextFrameFn = MyContextFrame;
+    mcc->ParallelForFn = MyParallelFor;
+    ...
+    // Every frame: PreNewFrameUpdateAll(), then NewFrame() + ContextFrameFn + Render() of all contexts in parallel, then join.
+    ImGuiMultiContextCompositor_NewFrameRenderAll(mcc);
+    // Render ImGui::GetDrawData() of each context, then
+    ImGuiMultiContextCompositor_PostEndFrameUpdateAll(mcc);
+*/
+
+// USAGE (SKIPPING IDLE CONTEXTS):
+/*
+    mcc->SkipIdleContexts = true;
+    ...
+    ImGuiMultiContextCompositor_SetContextDirty(mcc, ctx2); // Whenever data displayed by ctx2 changed
+    ...
+    ImGuiMultiContextCompositor_PreNewFrameUpdateAll(mcc);
+    if (ImGuiMultiContextCompositor_ContextNeedsUpdate(mcc, ctx1))
+    {
+        ImGui::SetCurrentContext(ctx1);
+        ImGui::NewFrame();
+        ImGuiMultiContextCompositor_PostNewFrameUpdateOne(mcc, ctx1);
+        ...
+        ImGui::Render();
+    }
+    // Render ImGui::GetDrawData() of all contexts: idle contexts keep their last draw data.
+    // (ImGuiMultiContextCompositor_NewFrameRenderAll() only updates contexts in ContextsToUpdate)
+*/
+
+// USAGE (MERGED RENDERING):
+/*
+    // After calling Render() on all contexts, instead of rendering ImGui::GetDrawData() of each context:
+    ImGui::SetCurrentContext(ctx1); // Any context with your renderer backend initialized
+    ImGui_ImplXXXX_RenderDrawData(ImGuiMultiContextCompositor_GetMergedDrawData(mcc));
+    // Secondary viewports are owned by a single context and are still rendered by each context (e.g. ImGui::RenderPlatformWindowsDefault()).
+    // Textures of all contexts (e.g. font atlas) need to be usable by this renderer backend. Sharing a ImFontAtlas between contexts is easiest.
+*/
+
+// THREADING:
+// - Between PreNewFrameUpdateAll() and PostEndFrameUpdateAll() (the parallel phase), all fields of ImGuiMultiContextCompositor are read-only.
+//   PostNewFrameUpdateOne() only reads CtxDragDropSrc, CtxDragDropDst, DragDropPayload, DragDropPayloadChanged and writes to its own context.
+//   DragDropPayloadNoCopy is ignored when ParallelForFn is set, as source context may write its payload while destination context reads it.
+//   Don't call AddContext()/RemoveContext() or modify Contexts from ContextFrameFn.
+// - Contexts may only be touched by the job updating them. Don't access another context from ContextFrameFn.
+// - Dear ImGui requires a thread-local current context to call it from multiple threads: e.g. '#define GImGui MyImGuiTLS' in your imconfig.h
+//   with 'thread_local ImGuiContext* MyImGuiTLS;' defined in one .cpp file (see comments above GImGui in imgui.cpp).
+// - Contexts sharing a ImFontAtlas need it to be built before the parallel phase. Memory allocators (SetAllocatorFunctions()) must be thread-safe.
+
 #pragma once
 
 #include "imgui.h"
 
+enum { ImGuiMultiContextCompositor_StatsHistorySize = 120 };
+
+// Per-context statistics, published by PostEndFrameUpdateAll()
+struct ImGuiMultiContextCompositorStats
+{
+    float           NewFrameMs = 0.0f;          // Time spent in NewFrame() (requires GetTimeFn)
+    float           BuildMs = 0.0f;             // Time spent between NewFrame() and Render(), submitting UI (requires GetTimeFn)
+    float           RenderMs = 0.0f;            // Time spent in Render() (requires GetTimeFn)
+    int             VtxCount = 0;               // Vertices in draw data of all viewports of the context
+    int             IdxCount = 0;               // Indices in draw data of all viewports of the context
+    bool            Updated = false;            // Context was updated this frame (false when skipped as idle, see SkipIdleContexts)
+    bool            Hovered = false;            // Mouse hit-tested a window of the context
+    bool            MouseRouted = false;        // Mouse inputs were enabled
+    bool            KeyboardRouted = false;     // Keyboard inputs were enabled
+};
+
+// [Internal] Rectangle of a top-level window, cached for hit-testing
+struct ImGuiMultiContextCompositorRect
+{
+    ImVec2          Min, Max;                   // Including hovering padding
+    ImGuiID         ViewportId;                 // 0 without docking branch
+};
+
+// [Internal] Per-context data. Slots are linked in z-order and reused after RemoveContext().
+struct ImGuiMultiContextCompositorSlot
+{
+    ImGuiContext*   Ctx = NULL;                 // NULL when slot is free
+    int             Prev = -1;                  // Slot in front of this one, or next free slot
+    int             Next = -1;                  // Slot behind this one
+    int             ContextsIndex = -1;         // Index in ImGuiMultiContextCompositor::Contexts[]
+
+    // Cached by PostEndFrameUpdateAll(), stored in ImGuiMultiContextCompositor::WindowsRects[]/ExclusiveViewports[]
+    int             RectsOffset = 0;
+    int             RectsCount = 0;
+    int             ExclusiveViewportsOffset = 0;
+    int             ExclusiveViewportsCount = 0;
+    ImVec2          BoundsMin, BoundsMax;       // Bounding box of all rectangles
+    bool            HasModal = false;           // Capture mouse everywhere
+    bool            RectsValid = false;         // Set after first PostEndFrameUpdateAll() call. Routing uses previous frame state until then.
+
+    // Idle contexts skipping
+    bool            Hovered = false;            // Hit-tested this frame
+    bool            WasHovered = false;
+    bool            Dirty = false;              // Set by ImGuiMultiContextCompositor_SetContextDirty()
+    bool            NeedsUpdate = true;
+    int             IdleFrames = 0;
+    ImVec2          LastDisplaySize;
+
+    // Statistics
+    ImGuiMultiContextCompositorStats Stats;
+    float           StatsHistoryMs[ImGuiMultiContextCompositor_StatsHistorySize] = {}; // NewFrame + build + Render time of last frames
+    ImGuiID         StatsHookIds[4] = {};       // Context hooks measuring time, when GetTimeFn was set by AddContext()
+    double          StatsHookTimes[4] = {};     // NewFrame/Render pre/post times. Written by context hooks, from thread updating the context.
+};
+
 struct ImGuiMultiContextCompositor
 {
-    // List of context + sorted front to back
+    // List of contexts. RemoveContext() moves last context to the removed one's index.
     ImVector<ImGuiContext*> Contexts;
-    ImVector<ImGuiContext*> ContextsFrontToBack;
+    ImVector<ImGuiContext*> ContextsFrontToBack;// [Compat] Sorted front to back. Only built by ImGuiMultiContextCompositor_GetContextsFrontToBack(), don't read directly.
+
+    // [Internal] Z-order
+    ImVector<ImGuiMultiContextCompositorSlot> Slots;
+    ImGuiStorage    SlotsMap;                   // Hash of context pointer -> slot index + 1
+    int             SlotFront = -1;
+    int             SlotBack = -1;
+    int             SlotFreeList = -1;
+    bool            ContextsFrontToBackDirty = true;
+
+    // [Internal] Hit-testing data, rebuilt by PostEndFrameUpdateAll()
+    ImVector<ImGuiMultiContextCompositorRect> WindowsRects;
+    ImVector<ImGuiID> ExclusiveViewports;    // Viewports not hosting other windows (secondary viewports) of each context
 
     // [Internal]
     ImGuiContext*   CtxMouseFirst = NULL;       // When hovering a main/shared viewport, first context with io.WantCaptureMouse
@@ -61,7 +197,43 @@ struct ImGuiMultiContextCompositor
     ImGuiContext*   CtxKeyboardExclusive = NULL;// When focusing a secondary viewport
     ImGuiContext*   CtxDragDropSrc = NULL;      // Source context for drag and drop
     ImGuiContext*   CtxDragDropDst = NULL;      // When hovering a main/shared viewport, second context with io.WantCaptureMouse for Drag Drop target
-    ImGuiPayload    DragDropPayload;            // Deep copy of drag and drop payload.
+    ImGuiPayload    DragDropPayload;            // Copy of drag and drop payload. Data points to DragDropPayloadBufHeap (or source context payload data when using DragDropPayloadNoCopy).
+    ImVector<unsigned char> DragDropPayloadBufHeap; // Persistent copy of payload data, only copied again when source payload changed. Freed when drag and drop ends.
+    bool            DragDropPayloadChanged = false; // Payload changed this frame (destination context copies it again).
+    bool            DragDropPayloadNoCopy = false;  // Setting: pass source context payload data directly to destination context. Only when contexts are updated one after another, from the same thread.
+
+    // Idle contexts skipping (optional)
+    bool            SkipIdleContexts = false;   // Setting: only update contexts with routed inputs, drag and drop, hovered/active item or dirty flag. Check ImGuiMultiContextCompositor_ContextNeedsUpdate() before calling NewFrame().
+    int             SkipIdleContextsDelay = 3;  // Setting: number of idle frames still updated before skipping a context (lets windows settle, e.g. auto-resizing).
+    ImVector<ImGuiContext*> ContextsToUpdate;   // Contexts needing update this frame, in Contexts order. Set by PreNewFrameUpdateAll().
+
+    // Statistics (optional)
+    double          (*GetTimeFn)(void* user_data) = NULL; // Setting: return current time in seconds from a high resolution clock. Set before adding contexts to measure NewFrame()/Render() times using context hooks.
+    int             FocusChanges = 0;           // Number of times keyboard owner changed (e.g. after bringing a context to front)
+    int             MouseRoutingChanges = 0;    // Number of times mouse owner (CtxMouseFirst, CtxMouseExclusive) changed
+    float           FocusChangesPerSecond = 0.0f;
+    float           MouseRoutingChangesPerSecond = 0.0f;
+
+    // [Internal] Statistics
+    int             StatsHistoryOffset = 0;
+    float           StatsHistoryDeltaTime[ImGuiMultiContextCompositor_StatsHistorySize] = {};
+    int             StatsHistoryFocusChanges[ImGuiMultiContextCompositor_StatsHistorySize] = {};
+    int             StatsHistoryMouseRoutingChanges[ImGuiMultiContextCompositor_StatsHistorySize] = {};
+    int             StatsFrameFocusChanges = 0;
+    int             StatsFrameMouseRoutingChanges = 0;
+    ImGuiContext*   StatsCtxKeyboardPrev = NULL;
+    ImGuiContext*   StatsCtxMousePrev = NULL;
+
+    // [Internal] Merged rendering
+    ImDrawData      MergedDrawData;             // Output of ImGuiMultiContextCompositor_GetMergedDrawData()
+    ImVector<ImDrawList*> MergedTopDrawLists;   // Tooltips and foreground draw lists, drawn after all contexts
+    ImVector<ImDrawList*> MergedTooltipDrawLists;// Draw lists of tooltip windows of one context (temporary)
+    bool            MergedDrawDataUsed = false; // Set by GetMergedDrawData(): tooltips are always visible, allowing to bring drag target context to front.
+
+    // Threaded driver (optional, for ImGuiMultiContextCompositor_NewFrameRenderAll())
+    void            (*ContextFrameFn)(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx, void* user_data) = NULL; // Submit UI of 'ctx', called between NewFrame() and Render() with 'ctx' as current context.
+    void            (*ParallelForFn)(void (*job_fn)(void* job_data, int job_n), void* job_data, int jobs_count, void* user_data) = NULL; // Call job_fn(job_data, 0..jobs_count-1) in parallel and return once they are all done. When NULL, contexts are updated one after another.
+    void*           UserData = NULL;            // Passed to ContextFrameFn and ParallelForFn.
 };
 
 //-----------------------------------------------------------------------------
@@ -69,17 +241,39 @@ struct ImGuiMultiContextCompositor
 //-----------------------------------------------------------------------------
 
 // Add/remove context.
+// When GetTimeFn is set, context hooks are added to measure time: call RemoveContext() before destroying a context.
 void ImGuiMultiContextCompositor_AddContext(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
 void ImGuiMultiContextCompositor_RemoveContext(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
 
+// Contexts sorted front to back, rebuilt if z-order changed since last call (cost scales with contexts count, the compositor itself walks slots links instead).
+const ImVector<ImGuiContext*>& ImGuiMultiContextCompositor_GetContextsFrontToBack(ImGuiMultiContextCompositor* mcc);
+
 // Call at a shared sync point before calling NewFrame() on any context.
 void ImGuiMultiContextCompositor_PreNewFrameUpdateAll(ImGuiMultiContextCompositor* mcc);
 
+// Optional: when using SkipIdleContexts, call after PreNewFrameUpdateAll() to know if NewFrame()/Render() needs to be called on a context.
+// Idle contexts keep their last ImDrawData. Always true when SkipIdleContexts is false.
+bool ImGuiMultiContextCompositor_ContextNeedsUpdate(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
+
+// Optional: request a context to be updated next frame (e.g. data it displays changed). Call before PreNewFrameUpdateAll(), from the same thread.
+void ImGuiMultiContextCompositor_SetContextDirty(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
+
 // Call after caling NewFrame() on a given context.
 void ImGuiMultiContextCompositor_PostNewFrameUpdateOne(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
 
 // Call at a shared sync point after calling EndFrame() on all contexts.
 void ImGuiMultiContextCompositor_PostEndFrameUpdateAll(ImGuiMultiContextCompositor* mcc);
 
+// Optional threaded driver: call PreNewFrameUpdateAll(), then NewFrame() + PostNewFrameUpdateOne() + ContextFrameFn + Render() on each context
+// from ParallelForFn jobs, and return once all contexts are rendered. Call PostEndFrameUpdateAll() after rendering their draw data.
+void ImGuiMultiContextCompositor_NewFrameRenderAll(ImGuiMultiContextCompositor* mcc);
+
+// Merge main viewport draw data of all contexts, back to front. Tooltips and foreground draw lists are lifted above all contexts.
+// Call after calling Render() on all contexts. Draw lists are owned by contexts: data is valid until next NewFrame() of any context.
+ImDrawData* ImGuiMultiContextCompositor_GetMergedDrawData(ImGuiMultiContextCompositor* mcc);
+
+// Statistics of a context, published by PostEndFrameUpdateAll(). NULL if context wasn't added.
+const ImGuiMultiContextCompositorStats* ImGuiMultiContextCompositor_GetContextStats(ImGuiMultiContextCompositor* mcc, ImGuiContext* ctx);
+
 // Debug display
 void ImGuiMultiContextCompositor_ShowDebugWindow(ImGuiMultiContextCompositor* mcc);